@@ -15,6 +15,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2022-XX-XX: OpenGL: Upload the font texture as a single channel (GL_R8 expanded to white + alpha by texture swizzle) when GL 3.3+/ES 3.0 or GL_ARB_texture_swizzle is available and the atlas has no colors.
+//  2022-XX-XX: OpenGL: Threshold the font texture in the fragment shader when the atlas is built with ImFontAtlasFlags_SignedDistanceField.
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2021-12-15: OpenGL: Using buffer orphaning + glBufferSubData(), seems to fix leaks with multi-viewports with some Intel HD drivers.
 //  2021-08-23: OpenGL: Fixed ES 3.0 shader ("#version 300 es") use normal precision floats to avoid wobbly rendering at HD resolutions.
@@ -178,6 +180,24 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0 have single channel GL_R8 textures with texture swizzle (not in our stripped loader)
+#ifndef IMGUI_IMPL_OPENGL_ES2
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#ifndef GL_R8
+#define GL_RED                  0x1903
+#define GL_R8                   0x8229
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_R
+#define GL_TEXTURE_SWIZZLE_R    0x8E42
+#define GL_TEXTURE_SWIZZLE_G    0x8E43
+#define GL_TEXTURE_SWIZZLE_B    0x8E44
+#define GL_TEXTURE_SWIZZLE_A    0x8E45
+#endif
+#ifndef GL_UNPACK_ALIGNMENT
+#define GL_UNPACK_ALIGNMENT     0x0CF5
+#endif
+#endif
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -187,6 +207,7 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdf;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -194,6 +215,7 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
+    bool            HasTextureSwizzle;
 
     ImGui_ImplOpenGL3_Data() { memset(this, 0, sizeof(*this)); }
 };
@@ -277,6 +299,11 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 
     // Detect extensions we support
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+    bd->HasTextureSwizzle = true;
+#elif defined(IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE)
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -285,6 +312,8 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != NULL && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != NULL && strcmp(extension, "GL_ARB_texture_swizzle") == 0)
+            bd->HasTextureSwizzle = true;
     }
 #endif
 
@@ -367,6 +396,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniform1i(bd->AttribLocationSdf, 0);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
@@ -447,6 +477,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // The font texture holds distance fields to threshold instead of coverage; other textures are drawn as they are
+    const bool sdf_fonts = (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    bool sdf_enabled = false;
+
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
@@ -479,6 +513,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
+                sdf_enabled = false;
             }
             else
             {
@@ -493,6 +528,12 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                const bool sdf = sdf_fonts && (GLuint)(intptr_t)pcmd->GetTexID() == bd->FontTexture;
+                if (sdf != sdf_enabled)
+                {
+                    glUniform1i(bd->AttribLocationSdf, sdf ? 1 : 0);
+                    sdf_enabled = sdf;
+                }
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
@@ -545,9 +586,16 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Build texture atlas
+    // A text-only atlas is uploaded as one byte per texel and sampled as (1,1,1,alpha) through the texture swizzle, which
+    // is what the shaders and user callbacks see from the RGBA 32-bit texture. Atlases with colored pixels, and contexts
+    // without texture swizzle, use RGBA 32-bit (75% of the memory is wasted, but it works everywhere).
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    const bool alpha8 = bd->HasTextureSwizzle && !io.Fonts->TexPixelsUseColors;
+    if (alpha8)
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    else
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
     // Upload texture to graphics system
     GLint last_texture;
@@ -558,6 +606,21 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (alpha8)
+    {
+        GLint last_unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment);
+    }
+    else
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
@@ -694,47 +757,81 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // With Sdf set, texture alpha is a distance field: 0.5 on the outline, antialiased over about one pixel on screen at any scale
     const GLchar* fragment_shader_glsl_120 =
         "#ifdef GL_ES\n"
+        "#extension GL_OES_standard_derivatives : enable\n"
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool Sdf;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 texel = texture2D(Texture, Frag_UV.st);\n"
+        "    if (Sdf)\n"
+        "    {\n"
+        "#if defined(GL_ES) && !defined(GL_OES_standard_derivatives)\n"
+        "        float w = 0.1;\n"
+        "#else\n"
+        "        float w = max(fwidth(texel.a) * 0.5, 0.001);\n"
+        "#endif\n"
+        "        texel.a = smoothstep(0.5 - w, 0.5 + w, texel.a);\n"
+        "    }\n"
+        "    gl_FragColor = Frag_Color * texel;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform bool Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 texel = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf)\n"
+        "    {\n"
+        "        float w = max(fwidth(texel.a) * 0.5, 0.001);\n"
+        "        texel.a = smoothstep(0.5 - w, 0.5 + w, texel.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * texel;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 texel = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf)\n"
+        "    {\n"
+        "        float w = max(fwidth(texel.a) * 0.5, 0.001);\n"
+        "        texel.a = smoothstep(0.5 - w, 0.5 + w, texel.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * texel;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool Sdf;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 texel = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf)\n"
+        "    {\n"
+        "        float w = max(fwidth(texel.a) * 0.5, 0.001);\n"
+        "        texel.a = smoothstep(0.5 - w, 0.5 + w, texel.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * texel;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -788,6 +885,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdf = glGetUniformLocation(bd->ShaderHandle, "Sdf");
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -0,0 +1,380 @@
+// dear imgui: Renderer Backend for a CPU framebuffer (software rasterizer)
+// This needs no GPU and no window: draw data is rasterized into a caller owned RGBA buffer.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftraster_Texture*' as ImTextureID, see ImGui_ImplSoftraster_CreateTexture().
+//  [X] Renderer: Large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Textured, alpha blended and scissored triangles, bilinear sampling.
+//  [X] Renderer: Multi-threaded by screen tiles.
+
+// How it works:
+//  - Every triangle is set up once: 28.4 fixed point vertices, edge functions, clip rectangle.
+//  - Triangles are binned into TILE_SIZE x TILE_SIZE tiles, in submission order.
+//  - Worker threads take tiles from an atomic counter and rasterize the bin of each tile inside
+//    it. A pixel only ever belongs to one tile, so blending order is the submission order and the
+//    output is exact and independent of the number of threads.
+//  - Coverage uses the top-left fill rule on pixel centers, so the two triangles of a quad never
+//    blend an edge pixel twice.
+
+#include "imgui.h"
+#include "imgui_impl_softraster.h"
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+template<typename T> static inline T SrMin(T a, T b) { return a < b ? a : b; }
+template<typename T> static inline T SrMax(T a, T b) { return a >= b ? a : b; }
+template<typename T> static inline void SrSwap(T& a, T& b) { T tmp = a; a = b; b = tmp; }
+
+static const int TILE_SIZE = 64;
+static const int SUBPIXEL_BITS = 4;
+static const int SUBPIXEL_ONE = 1 << SUBPIXEL_BITS;
+
+struct ImGui_ImplSoftraster_Triangle
+{
+    const ImDrawVert*                   Vtx[3];         // counter clockwise on screen (area > 0)
+    const ImGui_ImplSoftraster_Texture* Texture;
+    long long                           X[3], Y[3];     // fixed point positions
+    long long                           Area;           // twice the area, fixed point squared
+    int                                 Bounds[4];      // pixel bounds (x0, y0, x1, y1 exclusive), clipped
+    bool                                FlatColor;
+};
+
+// Softraster Data
+struct ImGui_ImplSoftraster_Data
+{
+    int                                         ThreadCount;
+    ImGui_ImplSoftraster_Texture*               FontTexture;
+    std::vector<ImGui_ImplSoftraster_Triangle>  Triangles;
+    std::vector<std::vector<int> >              Bins;
+
+    ImGui_ImplSoftraster_Data() { ThreadCount = 1; FontTexture = NULL; }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplSoftraster_Data* ImGui_ImplSoftraster_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftraster_Data*)ImGui::GetIO().BackendRendererUserData : NULL;
+}
+
+// Functions
+bool    ImGui_ImplSoftraster_Init(int threads)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendRendererUserData == NULL && "Already initialized a renderer backend!");
+
+    ImGui_ImplSoftraster_Data* bd = IM_NEW(ImGui_ImplSoftraster_Data)();
+    bd->ThreadCount = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+    if (bd->ThreadCount < 1)
+        bd->ThreadCount = 1;
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    return true;
+}
+
+void    ImGui_ImplSoftraster_Shutdown()
+{
+    ImGui_ImplSoftraster_Data* bd = ImGui_ImplSoftraster_GetBackendData();
+    IM_ASSERT(bd != NULL && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui_ImplSoftraster_DestroyFontsTexture();
+    io.BackendRendererName = NULL;
+    io.BackendRendererUserData = NULL;
+    IM_DELETE(bd);
+}
+
+void    ImGui_ImplSoftraster_NewFrame()
+{
+    ImGui_ImplSoftraster_Data* bd = ImGui_ImplSoftraster_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoftraster_Init()?");
+
+    if (!bd->FontTexture)
+        ImGui_ImplSoftraster_CreateFontsTexture();
+}
+
+ImTextureID ImGui_ImplSoftraster_CreateTexture(const unsigned char* rgba, int width, int height)
+{
+    ImGui_ImplSoftraster_Texture* texture = IM_NEW(ImGui_ImplSoftraster_Texture)();
+    texture->Width = width;
+    texture->Height = height;
+    texture->Pixels = (ImU32*)IM_ALLOC((size_t)width * height * 4);
+    memcpy(texture->Pixels, rgba, (size_t)width * height * 4);
+    return (ImTextureID)texture;
+}
+
+void    ImGui_ImplSoftraster_DestroyTexture(ImTextureID texture_id)
+{
+    ImGui_ImplSoftraster_Texture* texture = (ImGui_ImplSoftraster_Texture*)texture_id;
+    if (!texture)
+        return;
+    IM_FREE(texture->Pixels);
+    IM_DELETE(texture);
+}
+
+bool    ImGui_ImplSoftraster_CreateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftraster_Data* bd = ImGui_ImplSoftraster_GetBackendData();
+
+    // Build texture atlas
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontTexture = (ImGui_ImplSoftraster_Texture*)ImGui_ImplSoftraster_CreateTexture(pixels, width, height);
+    io.Fonts->SetTexID((ImTextureID)bd->FontTexture);
+    return true;
+}
+
+void    ImGui_ImplSoftraster_DestroyFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftraster_Data* bd = ImGui_ImplSoftraster_GetBackendData();
+    if (bd->FontTexture)
+    {
+        ImGui_ImplSoftraster_DestroyTexture((ImTextureID)bd->FontTexture);
+        io.Fonts->SetTexID(0);
+        bd->FontTexture = NULL;
+    }
+}
+
+// (x * y + 127) / 255 for x, y in [0, 255], exact
+static inline unsigned int ImGui_ImplSoftraster_Mul8(unsigned int x, unsigned int y)
+{
+    unsigned int t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Bilinear sample at normalized (u, v), clamped to the edges like GL_CLAMP_TO_EDGE
+static inline ImU32 ImGui_ImplSoftraster_Sample(const ImGui_ImplSoftraster_Texture* tex, float u, float v)
+{
+    float fx = u * tex->Width - 0.5f;
+    float fy = v * tex->Height - 0.5f;
+    float flx = floorf(fx), fly = floorf(fy);
+    int x0 = (int)flx, y0 = (int)fly;
+    unsigned int ax = (unsigned int)((fx - flx) * 256.0f), ay = (unsigned int)((fy - fly) * 256.0f);
+    int x1 = x0 + 1, y1 = y0 + 1;
+    x0 = x0 < 0 ? 0 : x0 >= tex->Width ? tex->Width - 1 : x0;
+    x1 = x1 < 0 ? 0 : x1 >= tex->Width ? tex->Width - 1 : x1;
+    y0 = y0 < 0 ? 0 : y0 >= tex->Height ? tex->Height - 1 : y0;
+    y1 = y1 < 0 ? 0 : y1 >= tex->Height ? tex->Height - 1 : y1;
+    ImU32 c00 = tex->Pixels[y0 * tex->Width + x0], c10 = tex->Pixels[y0 * tex->Width + x1];
+    ImU32 c01 = tex->Pixels[y1 * tex->Width + x0], c11 = tex->Pixels[y1 * tex->Width + x1];
+    if (c00 == c10 && c00 == c01 && c00 == c11)
+        return c00;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        unsigned int top = ((c00 >> shift) & 0xFF) * (256 - ax) + ((c10 >> shift) & 0xFF) * ax;
+        unsigned int bottom = ((c01 >> shift) & 0xFF) * (256 - ax) + ((c11 >> shift) & 0xFF) * ax;
+        out |= ((top * (256 - ay) + bottom * ay + (1 << 15)) >> 16) << shift;
+    }
+    return out;
+}
+
+// src over dst: rgb = src * a + dst * (1 - a), alpha = a + dst alpha * (1 - a)
+static inline ImU32 ImGui_ImplSoftraster_Blend(ImU32 src, ImU32 dst)
+{
+    unsigned int a = src >> IM_COL32_A_SHIFT;
+    if (a == 255)
+        return src;
+    if (a == 0)
+        return dst;
+    unsigned int inv = 255 - a;
+    unsigned int r = ImGui_ImplSoftraster_Mul8((src >> IM_COL32_R_SHIFT) & 0xFF, a) + ImGui_ImplSoftraster_Mul8((dst >> IM_COL32_R_SHIFT) & 0xFF, inv);
+    unsigned int g = ImGui_ImplSoftraster_Mul8((src >> IM_COL32_G_SHIFT) & 0xFF, a) + ImGui_ImplSoftraster_Mul8((dst >> IM_COL32_G_SHIFT) & 0xFF, inv);
+    unsigned int b = ImGui_ImplSoftraster_Mul8((src >> IM_COL32_B_SHIFT) & 0xFF, a) + ImGui_ImplSoftraster_Mul8((dst >> IM_COL32_B_SHIFT) & 0xFF, inv);
+    unsigned int oa = a + ImGui_ImplSoftraster_Mul8(dst >> IM_COL32_A_SHIFT, inv);
+    return (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | ((oa > 255 ? 255 : oa) << IM_COL32_A_SHIFT);
+}
+
+static inline ImU32 ImGui_ImplSoftraster_Modulate(ImU32 color, ImU32 texel)
+{
+    if (texel == 0xFFFFFFFF)
+        return color;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ImGui_ImplSoftraster_Mul8((color >> shift) & 0xFF, (texel >> shift) & 0xFF) << shift;
+    return out;
+}
+
+static ImU32 ImGui_ImplSoftraster_LerpColor(const ImGui_ImplSoftraster_Triangle& tri, float l1, float l2)
+{
+    ImU32 c0 = tri.Vtx[0]->col, c1 = tri.Vtx[1]->col, c2 = tri.Vtx[2]->col;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        float a = (float)((c0 >> shift) & 0xFF), b = (float)((c1 >> shift) & 0xFF), c = (float)((c2 >> shift) & 0xFF);
+        int value = (int)(a + (b - a) * l1 + (c - a) * l2 + 0.5f);
+        out |= (ImU32)(value < 0 ? 0 : value > 255 ? 255 : value) << shift;
+    }
+    return out;
+}
+
+// Rasterizes one triangle inside [x0, x1) x [y0, y1)
+static void ImGui_ImplSoftraster_RasterTriangle(const ImGui_ImplSoftraster_Triangle& tri, int x0, int y0, int x1, int y1, ImU32* pixels, int stride)
+{
+    x0 = SrMax(x0, tri.Bounds[0]);
+    y0 = SrMax(y0, tri.Bounds[1]);
+    x1 = SrMin(x1, tri.Bounds[2]);
+    y1 = SrMin(y1, tri.Bounds[3]);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    // Edge i is opposite to vertex i, its function is the (scaled) barycentric weight of vertex i.
+    // E(p) = A * px + B * py + C, positive inside; top-left edges include their pixels, others not.
+    long long A[3], B[3], C[3], bias[3];
+    for (int i = 0; i < 3; i++)
+    {
+        int a = (i + 1) % 3, b = (i + 2) % 3;
+        long long dx = tri.X[b] - tri.X[a], dy = tri.Y[b] - tri.Y[a];
+        A[i] = -dy;
+        B[i] = dx;
+        C[i] = dy * tri.X[a] - dx * tri.Y[a];
+        bool top_left = (dy < 0) || (dy == 0 && dx > 0);
+        bias[i] = top_left ? 0 : -1;
+    }
+    const long long px0 = (long long)x0 * SUBPIXEL_ONE + SUBPIXEL_ONE / 2;
+    const long long py0 = (long long)y0 * SUBPIXEL_ONE + SUBPIXEL_ONE / 2;
+    long long row[3];
+    for (int i = 0; i < 3; i++)
+        row[i] = A[i] * px0 + B[i] * py0 + C[i] + bias[i];
+
+    const ImVec2 uv0 = tri.Vtx[0]->uv, uv1 = tri.Vtx[1]->uv, uv2 = tri.Vtx[2]->uv;
+    const float inv_area = 1.0f / (float)tri.Area;
+    const ImGui_ImplSoftraster_Texture* tex = tri.Texture;
+    for (int y = y0; y < y1; y++)
+    {
+        long long w0 = row[0], w1 = row[1], w2 = row[2];
+        ImU32* dst = pixels + (size_t)y * stride;
+        for (int x = x0; x < x1; x++)
+        {
+            if ((w0 | w1 | w2) >= 0)
+            {
+                // undo the bias before interpolating
+                float l1 = (float)(w1 - bias[1]) * inv_area;
+                float l2 = (float)(w2 - bias[2]) * inv_area;
+                ImU32 color = tri.FlatColor ? tri.Vtx[0]->col : ImGui_ImplSoftraster_LerpColor(tri, l1, l2);
+                if (tex)
+                {
+                    float u = uv0.x + (uv1.x - uv0.x) * l1 + (uv2.x - uv0.x) * l2;
+                    float v = uv0.y + (uv1.y - uv0.y) * l1 + (uv2.y - uv0.y) * l2;
+                    color = ImGui_ImplSoftraster_Modulate(color, ImGui_ImplSoftraster_Sample(tex, u, v));
+                }
+                dst[x] = ImGui_ImplSoftraster_Blend(color, dst[x]);
+            }
+            w0 += A[0] * SUBPIXEL_ONE;
+            w1 += A[1] * SUBPIXEL_ONE;
+            w2 += A[2] * SUBPIXEL_ONE;
+        }
+        for (int i = 0; i < 3; i++)
+            row[i] += B[i] * SUBPIXEL_ONE;
+    }
+}
+
+void    ImGui_ImplSoftraster_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height)
+{
+    ImGui_ImplSoftraster_Data* bd = ImGui_ImplSoftraster_GetBackendData();
+    if (width <= 0 || height <= 0 || draw_data->TotalVtxCount == 0)
+        return;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Set up the triangles
+    bd->Triangles.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // ImDrawCallback_ResetRenderState has no state to reset here
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+            int clip_x0 = SrMax(0, (int)floorf((pcmd->ClipRect.x - clip_off.x) * clip_scale.x));
+            int clip_y0 = SrMax(0, (int)floorf((pcmd->ClipRect.y - clip_off.y) * clip_scale.y));
+            int clip_x1 = SrMin(width, (int)ceilf((pcmd->ClipRect.z - clip_off.x) * clip_scale.x));
+            int clip_y1 = SrMin(height, (int)ceilf((pcmd->ClipRect.w - clip_off.y) * clip_scale.y));
+            if (clip_x1 <= clip_x0 || clip_y1 <= clip_y0)
+                continue;
+
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+            {
+                ImGui_ImplSoftraster_Triangle tri;
+                for (int k = 0; k < 3; k++)
+                {
+                    tri.Vtx[k] = &vtx[idx[i + k]];
+                    tri.X[k] = (long long)floorf((tri.Vtx[k]->pos.x - clip_off.x) * clip_scale.x * SUBPIXEL_ONE + 0.5f);
+                    tri.Y[k] = (long long)floorf((tri.Vtx[k]->pos.y - clip_off.y) * clip_scale.y * SUBPIXEL_ONE + 0.5f);
+                }
+                tri.Area = (tri.X[1] - tri.X[0]) * (tri.Y[2] - tri.Y[0]) - (tri.Y[1] - tri.Y[0]) * (tri.X[2] - tri.X[0]);
+                if (tri.Area == 0)
+                    continue;
+                if (tri.Area < 0)
+                {
+                    SrSwap(tri.Vtx[1], tri.Vtx[2]);
+                    SrSwap(tri.X[1], tri.X[2]);
+                    SrSwap(tri.Y[1], tri.Y[2]);
+                    tri.Area = -tri.Area;
+                }
+                long long min_x = SrMin(tri.X[0], SrMin(tri.X[1], tri.X[2])), max_x = SrMax(tri.X[0], SrMax(tri.X[1], tri.X[2]));
+                long long min_y = SrMin(tri.Y[0], SrMin(tri.Y[1], tri.Y[2])), max_y = SrMax(tri.Y[0], SrMax(tri.Y[1], tri.Y[2]));
+                tri.Bounds[0] = SrMax(clip_x0, (int)(min_x >> SUBPIXEL_BITS));
+                tri.Bounds[1] = SrMax(clip_y0, (int)(min_y >> SUBPIXEL_BITS));
+                tri.Bounds[2] = SrMin(clip_x1, (int)((max_x + SUBPIXEL_ONE - 1) >> SUBPIXEL_BITS) + 1);
+                tri.Bounds[3] = SrMin(clip_y1, (int)((max_y + SUBPIXEL_ONE - 1) >> SUBPIXEL_BITS) + 1);
+                if (tri.Bounds[0] >= tri.Bounds[2] || tri.Bounds[1] >= tri.Bounds[3])
+                    continue;
+                tri.Texture = (const ImGui_ImplSoftraster_Texture*)pcmd->GetTexID();
+                tri.FlatColor = tri.Vtx[0]->col == tri.Vtx[1]->col && tri.Vtx[0]->col == tri.Vtx[2]->col;
+                bd->Triangles.push_back(tri);
+            }
+        }
+    }
+
+    // Bin them per tile, in order
+    const int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    const int tile_count = tiles_x * tiles_y;
+    bd->Bins.resize(tile_count);
+    for (int t = 0; t < tile_count; t++)
+        bd->Bins[t].resize(0);
+    for (int i = 0; i < (int)bd->Triangles.size(); i++)
+    {
+        const ImGui_ImplSoftraster_Triangle& tri = bd->Triangles[i];
+        for (int ty = tri.Bounds[1] / TILE_SIZE; ty <= (tri.Bounds[3] - 1) / TILE_SIZE; ty++)
+            for (int tx = tri.Bounds[0] / TILE_SIZE; tx <= (tri.Bounds[2] - 1) / TILE_SIZE; tx++)
+                bd->Bins[ty * tiles_x + tx].push_back(i);
+    }
+
+    // Rasterize the tiles
+    std::atomic<int> next_tile(0);
+    auto worker = [&]()
+    {
+        for (int t = next_tile++; t < tile_count; t = next_tile++)
+        {
+            int x0 = (t % tiles_x) * TILE_SIZE, y0 = (t / tiles_x) * TILE_SIZE;
+            int x1 = SrMin(x0 + TILE_SIZE, width), y1 = SrMin(y0 + TILE_SIZE, height);
+            for (int i : bd->Bins[t])
+                ImGui_ImplSoftraster_RasterTriangle(bd->Triangles[i], x0, y0, x1, y1, pixels, width);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < bd->ThreadCount && i < tile_count; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,35 @@
+// dear imgui: Renderer Backend for a CPU framebuffer (software rasterizer)
+// This needs no GPU and no window: draw data is rasterized into a caller owned RGBA buffer,
+// e.g. to render thumbnails on a build server. Use with a null platform (set io.DisplaySize yourself).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftraster_Texture*' as ImTextureID, see ImGui_ImplSoftraster_CreateTexture().
+//  [X] Renderer: Large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Textured, alpha blended (as glBlendFuncSeparate(SRC_ALPHA, ONE_MINUS_SRC_ALPHA, ONE, ONE_MINUS_SRC_ALPHA)) and scissored triangles, bilinear sampling.
+//  [X] Renderer: Multi-threaded: the framebuffer is cut into tiles, triangles are binned per tile and tiles are rasterized in parallel.
+//      The output does not depend on the number of threads.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+struct ImGui_ImplSoftraster_Texture
+{
+    int         Width;
+    int         Height;
+    ImU32*      Pixels;     // RGBA, same byte order as IM_COL32()
+};
+
+// Backend API
+IMGUI_IMPL_API bool     ImGui_ImplSoftraster_Init(int threads = 0);     // 0: one per hardware thread
+IMGUI_IMPL_API void     ImGui_ImplSoftraster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftraster_NewFrame();
+// Blends the draw data over pixels (width * height, row after row, IM_COL32() byte order)
+IMGUI_IMPL_API void     ImGui_ImplSoftraster_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height);
+
+// Textures (RGBA pixels are copied)
+IMGUI_IMPL_API ImTextureID ImGui_ImplSoftraster_CreateTexture(const unsigned char* rgba, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplSoftraster_DestroyTexture(ImTextureID texture);
+
+// (Optional) Called by NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoftraster_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftraster_DestroyFontsTexture();
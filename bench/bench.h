@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+// Shared by the benchmarks in this directory: each one times a hot path on generated input and
+// checks its output against a plain implementation, and exits with 1 when they disagree.
+
+#include "imgui.h"
+#include "Profiler.h"
+#include <stdio.h>
+
+// Best of repeats_ runs of fn_, in milliseconds: the minimum is the least disturbed by the rest of the system
+template<typename F>
+static double BenchBest(int repeats_, F fn_)
+{
+    double best = 1e30;
+    for (int i = 0; i < repeats_; ++i)
+    {
+        long long begin = Profiler::Now();
+        fn_();
+        double ms = (double)(Profiler::Now() - begin) / 1e6;
+        best = ms < best ? ms : best;
+    }
+    return best;
+}
+
+static inline double BenchMBps(size_t bytes_, double ms_)
+{
+    return ms_ > 0.0 ? (double)bytes_ / (1024.0 * 1024.0) / (ms_ / 1000.0) : 0.0;
+}
+
+// Small deterministic generator, so every run times the same input
+struct BenchRandom {
+    unsigned int state;
+    explicit BenchRandom(unsigned int seed_) : state(seed_) {}
+    unsigned int Next() { state = state * 1103515245u + 12345u; return state >> 8; }
+    unsigned int Next(unsigned int n_) { return Next() % n_; }
+};
+
+// Headless Dear ImGui context with the default font, for the benchmarks that lay out or draw text
+static inline void BenchCreateContext(float width_, float height_)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DeltaTime = 1.0f / 60.0f;
+    io.DisplaySize = ImVec2(width_, height_);
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+}
+
+#endif
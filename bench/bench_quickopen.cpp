@@ -0,0 +1,183 @@
+// Benchmark of the Ctrl+P matcher on a million generated note paths: a query scored over every
+// candidate, then the same query typed a character at a time, which only scores again the
+// candidates that matched the previous prefix. Every result list is checked against a plain
+// scorer run over all the paths and sorted.
+
+#include "bench.h"
+#include "QuickOpen.h"
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+static const int PATHS = 1000 * 1000;
+
+static const char* const Words[] = {
+    "notes", "journal", "Projects", "archive", "meeting", "draft", "ideas", "reading", "todo", "src",
+    "design", "Review", "weekly", "budget", "travel", "recipes", "garden", "widget", "parser", "render",
+};
+
+static inline unsigned char Fold(unsigned char c)
+{
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+static inline bool IsBoundary(char c)
+{
+    return c == '/' || c == '_' || c == '-' || c == '.' || c == ' ';
+}
+
+// FuzzyScore's rules, one character at a time: the shortest window ending at the leftmost match
+// of the whole query, scored on the greedy match inside it
+static int PlainScore(const char* query, int queryLength, const char* text, int textLength)
+{
+    if (queryLength == 0)
+        return 0;
+    int t = 0;
+    for (int q = 0; q < queryLength; ++q, ++t)
+    {
+        while (t < textLength && Fold((unsigned char)text[t]) != Fold((unsigned char)query[q]))
+            ++t;
+        if (t == textLength)
+            return FUZZYNOMATCH;
+    }
+    const int stop = t - 1;
+    int start = stop;
+    for (int q = queryLength - 1; start >= 0; --start)
+    {
+        if (Fold((unsigned char)text[start]) == Fold((unsigned char)query[q]) && --q < 0)
+            break;
+    }
+    int lastSlash = -1;
+    for (int i = 0; i < textLength; ++i)
+        if (text[i] == '/')
+            lastSlash = i;
+
+    int score = 0;
+    int previous = start - 1;
+    for (int q = 0; q < queryLength; ++q)
+    {
+        t = previous + 1;
+        while (Fold((unsigned char)text[t]) != Fold((unsigned char)query[q]))
+            ++t;
+        int bonus = 16;
+        if (t == 0 || text[t - 1] == '/')
+            bonus += 12;
+        else if (IsBoundary(text[t - 1]))
+            bonus += 10;
+        else if (text[t - 1] >= 'a' && text[t - 1] <= 'z' && text[t] >= 'A' && text[t] <= 'Z')
+            bonus += 8;
+        if (q > 0 && previous == t - 1)
+            bonus += 6;
+        if (t > lastSlash)
+            bonus += 4;
+        score += bonus - (q > 0 ? t - previous - 1 : 0);
+        previous = t;
+    }
+    return score - (textLength >> 3);
+}
+
+// Every path scored, sorted best first (then by index), the first TOPK kept
+static void PlainSearch(const char* query, const std::vector<const char*>& paths, const std::vector<int>& lengths, std::vector<QuickOpen::Result>& results)
+{
+    const int queryLength = (int)strlen(query);
+    results.clear();
+    for (int i = 0; i < (int)paths.size(); ++i)
+    {
+        int score = PlainScore(query, queryLength, paths[i], lengths[i]);
+        if (score != FUZZYNOMATCH)
+            results.push_back({ score, i });
+    }
+    std::sort(results.begin(), results.end(), [](const QuickOpen::Result& a, const QuickOpen::Result& b) { return a.score != b.score ? a.score > b.score : a.index < b.index; });
+    if ((int)results.size() > QuickOpen::TOPK)
+        results.resize(QuickOpen::TOPK);
+}
+
+static bool SameResults(const std::vector<QuickOpen::Result>& a, const std::vector<QuickOpen::Result>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].score != b[i].score || a[i].index != b[i].index)
+            return false;
+    return true;
+}
+
+int main()
+{
+    // folders of one to four words, then a file name of words joined by '_', '-' or camelCase
+    BenchRandom random(77);
+    std::vector<std::string> names(PATHS);
+    size_t bytes = 0;
+    for (std::string& name : names)
+    {
+        int folders = 1 + random.Next(4);
+        for (int i = 0; i < folders; ++i)
+        {
+            name += Words[random.Next(IM_ARRAYSIZE(Words))];
+            name += random.Next(4) == 0 ? "-" : "";
+            name += random.Next(3) == 0 ? std::to_string(random.Next(100)) : "";
+            name += "/";
+        }
+        int words = 1 + random.Next(3);
+        for (int i = 0; i < words; ++i)
+        {
+            std::string word = Words[random.Next(IM_ARRAYSIZE(Words))];
+            int join = random.Next(3);
+            if (i > 0 && join == 0)
+                name += "_";
+            else if (i > 0 && join == 1)
+                name += "-";
+            else if (i > 0)
+                word[0] = (char)(word[0] & ~0x20);
+            name += word;
+        }
+        name += ".md";
+        bytes += name.size();
+    }
+    std::vector<const char*> paths(PATHS);
+    std::vector<int> lengths(PATHS);
+    for (int i = 0; i < PATHS; ++i)
+    {
+        paths[i] = names[i].c_str();
+        lengths[i] = (int)names[i].size();
+    }
+
+    QuickOpen quickOpen;
+    double setMs = BenchBest(3, [&]() { quickOpen.SetCandidates(paths, lengths); });
+    printf("candidates      %d paths, %.1f MB\n", PATHS, bytes / (1024.0 * 1024.0));
+    printf("set candidates  %8.3f ms\n", setMs);
+
+    static const char* const Queries[] = { "wdgt", "notes/todo", "projrev", "mtgnotes", "zzq" };
+    bool ok = true;
+    printf("  %-12s %8s %12s %12s %12s %8s\n", "query", "results", "full ms", "per key ms", "plain ms", "speedup");
+    for (const char* query : Queries)
+    {
+        // the whole query at once: the empty query drops the candidates kept by the last search
+        double fullMs = BenchBest(5, [&]() { quickOpen.Search(""); quickOpen.Search(query); });
+        std::vector<QuickOpen::Result> full = quickOpen.results;
+
+        // typed a character at a time as the popup would see it, reported per keystroke
+        std::string typed;
+        double typedMs = BenchBest(5, [&]() {
+            quickOpen.Search("");
+            for (size_t i = 1; query[i - 1]; ++i)
+            {
+                typed.assign(query, i);
+                quickOpen.Search(typed.c_str());
+            }
+        });
+        std::vector<QuickOpen::Result> incremental = quickOpen.results;
+
+        std::vector<QuickOpen::Result> expected;
+        double plainMs = BenchBest(1, [&]() { PlainSearch(query, paths, lengths, expected); });
+        bool same = SameResults(full, expected) && SameResults(incremental, expected);
+        ok &= same;
+        printf("  %-12s %8d %12.3f %12.3f %12.3f %7.1fx%s\n", query, (int)full.size(), fullMs, typedMs / strlen(query), plainMs,
+            plainMs / (fullMs > 0.0 ? fullMs : 1e-6), same ? "" : "  MISMATCH");
+    }
+
+    if (!ok)
+        printf("FAILED: the matcher and the plain scorer disagree\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// Benchmark of the Ctrl+F trigram index on 100 MB of generated prose: query latency against a
+// linear scan of the text, and the cost of keeping the index up to date edit by edit against
+// building it again. Every query's matches are checked against the linear scan, before and
+// after the edits.
+
+#include "bench.h"
+#include "TrigramIndex.h"
+#include <string.h>
+#include <string>
+
+static const int TEXTBYTES = 100 * 1024 * 1024;
+static const int MAXMATCHES = 100000;       // as DocumentSearch
+static const int EDITS = 200;
+
+static const char* const Syllables[] = {
+    "ka", "lo", "mi", "ne", "ru", "ta", "so", "vi", "de", "pa", "gri", "sto", "fen", "mar", "qu", "el", "an", "or", "is", "the",
+};
+
+static inline unsigned char Fold(unsigned char c)
+{
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+// Plain search, with the index's rules: leftmost matches that do not overlap, at most maxMatches
+static void LinearFind(const char* text, int length, const char* query, int queryLength, bool caseSensitive, ImVector<int>& matches, int maxMatches)
+{
+    matches.resize(0);
+    for (int p = 0; p + queryLength <= length; )
+    {
+        bool match;
+        if (caseSensitive)
+        {
+            const char* hit = (const char*)memchr(text + p, query[0], (size_t)(length - queryLength + 1 - p));
+            if (!hit)
+                break;
+            p = (int)(hit - text);
+            match = memcmp(text + p, query, (size_t)queryLength) == 0;
+        }
+        else
+        {
+            match = true;
+            for (int i = 0; i < queryLength && match; ++i)
+                match = Fold((unsigned char)text[p + i]) == Fold((unsigned char)query[i]);
+        }
+        if (!match)
+        {
+            ++p;
+            continue;
+        }
+        matches.push_back(p);
+        if (matches.Size >= maxMatches)
+            return;
+        p += queryLength;
+    }
+}
+
+static std::string MakeText(BenchRandom& random)
+{
+    std::string text;
+    text.reserve(TEXTBYTES + 64);
+    while ((int)text.size() < TEXTBYTES)
+    {
+        int syllables = 1 + random.Next(3);
+        for (int i = 0; i < syllables; ++i)
+            text += Syllables[random.Next(IM_ARRAYSIZE(Syllables))];
+        int r = random.Next(100);
+        text += r < 8 ? ". " : r < 10 ? "\n\n" : r < 12 ? ", " : " ";
+        if (random.Next(200000) == 0)
+            text += "Zebrafish ";
+    }
+    return text;
+}
+
+struct Query {
+    const char* text;
+    bool        caseSensitive;
+};
+
+static bool RunQueries(const char* label, const TrigramIndex& index, const std::string& text)
+{
+    static const Query queries[] = {
+        { "zebrafish", false },             // rare word
+        { "Zebrafish", true },
+        { "quokka", false },                // absent: the bitmaps rule out every chunk
+        { "grisofen", false },              // a few hundred matches
+        { "the", false },                   // everywhere: stops at MAXMATCHES
+        { "ka", true },                     // shorter than a trigram: no filter
+    };
+    bool ok = true;
+    printf("%s\n", label);
+    printf("  %-12s %-6s %8s %12s %12s %8s\n", "query", "case", "matches", "index ms", "linear ms", "speedup");
+    for (const Query& query : queries)
+    {
+        ImVector<int> found, expected;
+        const int queryLength = (int)strlen(query.text);
+        double indexMs = BenchBest(5, [&]() { index.Find(text.data(), (int)text.size(), query.text, queryLength, query.caseSensitive, found, MAXMATCHES); });
+        double linearMs = BenchBest(3, [&]() { LinearFind(text.data(), (int)text.size(), query.text, queryLength, query.caseSensitive, expected, MAXMATCHES); });
+        bool same = found.Size == expected.Size && (found.Size == 0 || memcmp(found.Data, expected.Data, found.Size * sizeof(int)) == 0);
+        ok &= same;
+        printf("  %-12s %-6s %8d %12.3f %12.3f %7.1fx%s\n", query.text, query.caseSensitive ? "yes" : "no", found.Size,
+            indexMs, linearMs, linearMs / (indexMs > 0.0 ? indexMs : 1e-6), same ? "" : "  MISMATCH");
+    }
+    return ok;
+}
+
+int main()
+{
+    BenchRandom random(1234);
+    std::string text = MakeText(random);
+
+    TrigramIndex index;
+    double buildMs = BenchBest(3, [&]() { index.Build(text.data(), (int)text.size()); });
+    printf("text            %.1f MB, index %.1f MB\n", text.size() / (1024.0 * 1024.0), index.Bytes() / (1024.0 * 1024.0));
+    printf("build           %8.1f ms\n", buildMs);
+    bool ok = RunQueries("queries", index, text);
+
+    // typing-sized edits spread over the text: only the index update is timed
+    double updateMs = 0.0;
+    for (int i = 0; i < EDITS; ++i)
+    {
+        // replace, delete or insert a few bytes
+        ImGui::MarkdownEdit edit;
+        edit.pos = (int)random.Next((unsigned int)text.size() - 8);
+        edit.deleteLength = i % 3 != 2 ? 1 + (int)random.Next(8) : 0;
+        const char* insert = i % 5 == 0 ? "Zebrafish " : "ka";
+        edit.insertLength = i % 3 != 1 ? (int)strlen(insert) : 0;
+        text.replace(edit.pos, edit.deleteLength, insert, edit.insertLength);
+        long long begin = Profiler::Now();
+        index.Update(edit, text.data(), (int)text.size());
+        updateMs += (double)(Profiler::Now() - begin) / 1e6;
+    }
+    printf("update          %8.3f ms per edit (%d edits), build %.0fx slower\n", updateMs / EDITS, EDITS, buildMs / (updateMs / EDITS));
+    ok &= RunQueries("queries after the edits", index, text);
+
+    if (!ok)
+        printf("FAILED: the index and the linear scan disagree\n");
+    return ok ? 0 : 1;
+}
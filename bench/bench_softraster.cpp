@@ -0,0 +1,126 @@
+// Benchmark of the software rasterizer (imgui_impl_softraster): a fixed document of headings, prose,
+// lists, code blocks and tables, plus an image, drawn by the preview and rasterized with one thread
+// and with several. Tiles are rasterized in submission order whatever thread takes them, so every
+// image must be the same as the one thread image, byte for byte.
+
+#include "bench.h"
+#include "imgui_impl_softraster.h"
+#include "imgui_markdown.h"
+#include "MarkdownDocument.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+static const int WIDTH = 1280;
+static const int HEIGHT = 2400;
+static const int SECTIONS = 12;
+
+static const char* const Words[] = {
+    "render", "preview", "tile", "triangle", "*blend*", "**edge**", "pixel", "scissor", "texture", "atlas", "glyph", "row",
+};
+
+static std::string MakeDocument(BenchRandom& random)
+{
+    std::string text = "# Software rasterizer\n\n";
+    for (int s = 0; s < SECTIONS; ++s)
+    {
+        text += "## Section " + std::to_string(s) + "\n\n";
+        for (int i = 0, words = 40 + random.Next(60); i < words; ++i)
+        {
+            text += Words[random.Next(IM_ARRAYSIZE(Words))];
+            text += random.Next(12) == 0 ? ". " : " ";
+        }
+        text += "see [the docs](https://example.com).\n\n";
+        for (int i = 0; i < 3; ++i)
+            text += "- item " + std::to_string(i) + " with `code`\n";
+        text += "\n```cpp\nstatic int Count(int limit) { return limit > 0x1F ? limit : 0; } // clamp\n```\n\n";
+        text += "| left | center | right |\n|:-----|:------:|------:|\n";
+        for (int i = 0; i < 3; ++i)
+            text += "| " + std::to_string(random.Next(1000)) + " | cell | " + std::to_string(i) + " |\n";
+        text += "\n---\n\n";
+    }
+    return text;
+}
+
+// A context of its own with the rasterizer on threads threads: lays the document out at the image
+// size, rasterizes the last frame into pixels (cleared to the window background) and returns the
+// best rasterization time
+static double Render(const std::string& text, int threads, std::vector<ImU32>& pixels, ImU32* background)
+{
+    ImGui::MarkdownDocument doc;
+    doc.SetText(text.data(), text.size());
+    BenchCreateContext((float)WIDTH, (float)HEIGHT);
+    ImGui::StyleColorsDark();
+    ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w = 1.0f;
+    ImGui_ImplSoftraster_Init(threads);
+
+    // a gradient with an alpha ramp, sampled scaled so the bilinear filter is used
+    std::vector<unsigned char> rgba(64 * 64 * 4);
+    for (int y = 0; y < 64; ++y)
+        for (int x = 0; x < 64; ++x)
+        {
+            unsigned char* p = &rgba[(y * 64 + x) * 4];
+            p[0] = (unsigned char)(x * 4);
+            p[1] = (unsigned char)(y * 4);
+            p[2] = (unsigned char)((x ^ y) * 4);
+            p[3] = (unsigned char)(255 - x * 2);
+        }
+    ImTextureID image = ImGui_ImplSoftraster_CreateTexture(rgba.data(), 64, 64);
+
+    ImGui::MarkdownConfig config;
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        ImGui_ImplSoftraster_NewFrame();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("preview", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Image(image, ImVec2(173.0f, 97.0f));
+        ImGui::RenderMarkdownDocument(doc, config);
+        ImGui::End();
+        ImGui::Render();
+    }
+
+    *background = ImGui::GetColorU32(ImGuiCol_WindowBg);
+    double ms = BenchBest(5, [&]() {
+        pixels.assign((size_t)WIDTH * HEIGHT, *background);
+        ImGui_ImplSoftraster_RenderDrawData(ImGui::GetDrawData(), pixels.data(), WIDTH, HEIGHT);
+    });
+
+    ImGui_ImplSoftraster_DestroyTexture(image);
+    ImGui_ImplSoftraster_Shutdown();
+    ImGui::DestroyContext();
+    return ms;
+}
+
+int main()
+{
+    BenchRandom random(38);
+    const std::string text = MakeDocument(random);
+
+    std::vector<ImU32> reference;
+    ImU32 background;
+    const double referenceMs = Render(text, 1, reference, &background);
+    size_t drawn = 0;
+    for (ImU32 pixel : reference)
+        drawn += pixel != background;
+    printf("image           %d x %d, %.0f%% of the pixels not background\n", WIDTH, HEIGHT, 100.0 * drawn / reference.size());
+    printf("  %-8s %10s %8s\n", "threads", "ms", "speedup");
+    printf("  %-8d %10.3f %7.2fx\n", 1, referenceMs, 1.0);
+
+    // odd counts too, so the tiles are not shared out evenly
+    static const int Threads[] = { 2, 3, 4, 7, 16 };
+    bool ok = drawn > 0;
+    for (int threads : Threads)
+    {
+        std::vector<ImU32> pixels;
+        double ms = Render(text, threads, pixels, &background);
+        bool same = pixels.size() == reference.size() && memcmp(pixels.data(), reference.data(), reference.size() * sizeof(ImU32)) == 0;
+        ok &= same;
+        printf("  %-8d %10.3f %7.2fx%s\n", threads, ms, referenceMs / ms, same ? "" : "  MISMATCH");
+    }
+
+    if (!ok)
+        printf("FAILED: the rasterized images differ with the number of threads\n");
+    return ok ? 0 : 1;
+}
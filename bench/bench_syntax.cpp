@@ -0,0 +1,151 @@
+// Benchmark of the fenced code blocks: parsing and highlighting a document with thousands of code
+// lines, then preview frames with the per-block run cache against the same frames rebuilding it.
+// The runs are checked to stay inside their line, in order, and to cover every non-blank line,
+// and the document's running total of cache memory against the caches.
+
+#include "bench.h"
+#include "imgui_markdown.h"
+#include "MarkdownDocument.h"
+#include <string.h>
+#include <string>
+
+static const int LINESPERBLOCK = 5000;
+
+static const char* const CppLines[] = {
+    "#include <vector>",
+    "static int Count(const std::vector<int>& values, int limit) {",
+    "    int total = 0; // running sum",
+    "    for (size_t i = 0; i < values.size(); ++i) { if (values[i] > 0x1F) total += values[i]; }",
+    "    /* a block comment that goes",
+    "       over two lines */ return total > limit ? limit : total;",
+    "    const char* name = \"escaped \\\" quote\";",
+    "}",
+};
+
+static const char* const PythonLines[] = {
+    "def count(values, limit=10):",
+    "    total = 0  # running sum",
+    "    for v in values:",
+    "        if v is not None and v > 3.5e2:",
+    "            total += v",
+    "    return min(total, limit), 'done'",
+};
+
+static const char* const RustLines[] = {
+    "fn count(values: &[i32], limit: i32) -> i32 {",
+    "    let mut total = 0; // running sum",
+    "    for v in values.iter() { if *v > 31 { total += v; } }",
+    "    if total > limit { limit } else { total }",
+    "}",
+};
+
+static void AppendBlock(std::string& text, const char* lang, const char* const* lines, int lineCount)
+{
+    text += "Some prose before the block, with *emphasis* and a [link](https://example.com).\n\n```";
+    text += lang;
+    text += "\n";
+    for (int i = 0; i < LINESPERBLOCK; ++i)
+    {
+        text += lines[i % lineCount];
+        text += "\n";
+    }
+    text += "```\n\n";
+}
+
+// Every run inside its line, after the previous one, and every line with text has runs
+static bool CheckRuns(const ImGui::MarkdownDocument& doc, const ImGui::MarkdownBlock& block, const ImGui::MarkdownBlockCache& cache)
+{
+    const char* base = doc.Text() + block.contentStart;
+    const char* end = doc.Text() + block.contentStop;
+    int line = 0;
+    for (const char* p = base; p < end; ++line)
+    {
+        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+        if (!lineEnd)
+            lineEnd = end;
+        if (line + 1 >= cache.lineRuns.Size)
+            return false;
+        int previous = (int)(p - base);
+        for (int r = cache.lineRuns[line]; r < cache.lineRuns[line + 1]; ++r)
+        {
+            const SyntaxRun& run = cache.runs[r];
+            if (run.start < previous || run.length <= 0 || run.start + run.length > (int)(lineEnd - base))
+                return false;
+            previous = run.start + run.length;
+        }
+        if (lineEnd > p && cache.lineRuns[line] == cache.lineRuns[line + 1])
+            return false;
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+    return line + 1 == cache.lineRuns.Size;
+}
+
+static void Frame(ImGui::MarkdownDocument& doc, const ImGui::MarkdownConfig& config)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("preview", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+    ImGui::RenderMarkdownDocument(doc, config);
+    ImGui::End();
+    ImGui::Render();
+}
+
+int main()
+{
+    std::string text = "# Code blocks\n\n";
+    AppendBlock(text, "cpp", CppLines, IM_ARRAYSIZE(CppLines));
+    AppendBlock(text, "python", PythonLines, IM_ARRAYSIZE(PythonLines));
+    AppendBlock(text, "rust", RustLines, IM_ARRAYSIZE(RustLines));
+    const int codeLines = 3 * LINESPERBLOCK;
+
+    ImGui::MarkdownDocument doc;
+    double parseMs = BenchBest(5, [&]() { doc.SetText(text.data(), text.size()); });
+
+    bool ok = true;
+    int codeBlocks = 0;
+    double highlightMs = BenchBest(5, [&]() {
+        for (int i = 0; i < doc.blocks.Size; ++i)
+        {
+            if (doc.blocks[i].type != ImGui::MarkdownBlockType::CODE)
+                continue;
+            ImGui::MarkdownBlockCache cache;
+            ImGui::BuildCodeCache(doc, doc.blocks[i], cache);
+        }
+    });
+    for (int i = 0; i < doc.blocks.Size; ++i)
+    {
+        if (doc.blocks[i].type != ImGui::MarkdownBlockType::CODE)
+            continue;
+        ImGui::MarkdownBlockCache cache;
+        ImGui::BuildCodeCache(doc, doc.blocks[i], cache);
+        ok &= CheckRuns(doc, doc.blocks[i], cache);
+        ++codeBlocks;
+    }
+    ok &= codeBlocks == 3;
+
+    // frames of the preview showing the first code block: once its runs are cached, against
+    // rebuilding them every frame (what the cache saves)
+    const int FRAMES = 50;
+    BenchCreateContext(800.0f, 600.0f);
+    ImGui::MarkdownConfig config;
+    for (int i = 0; i < 4; ++i)
+        Frame(doc, config);
+    double cachedMs = BenchBest(3, [&]() { for (int i = 0; i < FRAMES; ++i) Frame(doc, config); }) / FRAMES;
+    double uncachedMs = BenchBest(3, [&]() { for (int i = 0; i < FRAMES; ++i) { doc.DropCaches(); Frame(doc, config); } }) / FRAMES;
+    // the running total of the cache memory agrees with the caches
+    size_t cacheBytes = 0;
+    for (const ImGui::MarkdownBlockCache& cache : doc.caches)
+        cacheBytes += cache.Bytes();
+    ok &= cacheBytes == doc.cacheBytes && cacheBytes > 0;
+    ImGui::DestroyContext();
+
+    printf("document        %zu bytes, %d code lines in %d blocks\n", text.size(), codeLines, codeBlocks);
+    printf("parse           %8.3f ms\n", parseMs);
+    printf("highlight       %8.3f ms   %.1f Mlines/s\n", highlightMs, codeLines / highlightMs / 1000.0);
+    printf("frame, cached   %8.3f ms\n", cachedMs);
+    printf("frame, rebuilt  %8.3f ms\n", uncachedMs);
+    if (!ok)
+        printf("FAILED: highlighted runs do not match the code lines, or the cache bytes are off\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,286 @@
+// Benchmark of text measurement and word wrapping (ImFont::CalcTextSizeA, CalcWordWrapPositionA) on
+// English prose and on mixed CJK / English text, against the one-character-at-a-time loops they
+// had before their ASCII fast path, kept below as the reference. Wrap positions and the stopping
+// point of a max width must be the same; widths may differ in the last bits, as the fast path sums
+// a run of advances in a different order.
+
+#include "bench.h"
+#include "imgui_internal.h"
+#include <math.h>
+#include <string.h>
+#include <string>
+
+static const int CORPUSBYTES = 1200 * 1024;
+static const float FONTSIZE = 16.0f;
+static const float WRAPWIDTH = 600.0f;
+static const int SAMPLES = 4000;
+
+static const char* const EnglishWords[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "markdown", "preview", "editor", "paragraph",
+    "renders", "with", "a", "wrapped", "line", "of", "text", "and", "code", "block", "(see", "below)", "it's",
+};
+static const char* const CjkWords[] = {
+    "\xe4\xb8\xad\xe6\x96\x87", "\xe6\x96\x87\xe6\xa1\xa3", "\xe9\xa2\x84\xe8\xa7\x88", "\xe7\xbc\x96\xe8\xbe\x91\xe5\x99\xa8",
+    "\xe6\xae\xb5\xe8\x90\xbd", "\xef\xbc\x8c", "\xe3\x80\x82",
+};
+static const char* const Punctuation[] = { " ", " ", " ", " ", " ", ", ", ". ", "; ", "! ", "? ", "  ", "\n" };
+
+// CalcWordWrapPositionA before the fast path
+static const char* RefWordWrapPosition(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
+{
+    float line_width = 0.0f;
+    float word_width = 0.0f;
+    float blank_width = 0.0f;
+    wrap_width /= scale;
+
+    const char* word_end = text;
+    const char* prev_word_end = NULL;
+    bool inside_word = true;
+
+    const char* s = text;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const char* next_s;
+        if (c < 0x80)
+            next_s = s + 1;
+        else
+            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+        if (c == 0)
+            break;
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                line_width = word_width = blank_width = 0.0f;
+                inside_word = true;
+                s = next_s;
+                continue;
+            }
+            if (c == '\r')
+            {
+                s = next_s;
+                continue;
+            }
+        }
+
+        const float char_width = font->GetCharAdvance((ImWchar)c);
+        if (ImCharIsBlankW(c))
+        {
+            if (inside_word)
+            {
+                line_width += blank_width;
+                blank_width = 0.0f;
+                word_end = s;
+            }
+            blank_width += char_width;
+            inside_word = false;
+        }
+        else
+        {
+            word_width += char_width;
+            if (inside_word)
+            {
+                word_end = next_s;
+            }
+            else
+            {
+                prev_word_end = word_end;
+                line_width += word_width + blank_width;
+                word_width = blank_width = 0.0f;
+            }
+            inside_word = (c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"');
+        }
+
+        if (line_width + word_width > wrap_width)
+        {
+            if (word_width < wrap_width)
+                s = prev_word_end ? prev_word_end : word_end;
+            break;
+        }
+
+        s = next_s;
+    }
+    return s;
+}
+
+// CalcTextSizeA before the fast path
+static ImVec2 RefTextSize(const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining)
+{
+    const float line_height = size;
+    const float scale = size / font->FontSize;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = RefWordWrapPosition(font, scale, s, text_end, wrap_width - line_width);
+                if (word_wrap_eol == s)
+                    word_wrap_eol++;
+            }
+
+            if (s >= word_wrap_eol)
+            {
+                if (text_size.x < line_width)
+                    text_size.x = line_width;
+                text_size.y += line_height;
+                line_width = 0.0f;
+                word_wrap_eol = NULL;
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                text_size.x = ImMax(text_size.x, line_width);
+                text_size.y += line_height;
+                line_width = 0.0f;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        const float char_width = font->GetCharAdvance((ImWchar)c) * scale;
+        if (line_width + char_width >= max_width)
+        {
+            s = prev_s;
+            break;
+        }
+        line_width += char_width;
+    }
+
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+    if (remaining)
+        *remaining = s;
+    return text_size;
+}
+
+static std::string MakeCorpus(BenchRandom& random, bool cjk)
+{
+    std::string text;
+    text.reserve(CORPUSBYTES + 64);
+    while ((int)text.size() < CORPUSBYTES)
+    {
+        if (cjk && random.Next(3) == 0)
+            text += CjkWords[random.Next(IM_ARRAYSIZE(CjkWords))];
+        else
+            text += EnglishWords[random.Next(IM_ARRAYSIZE(EnglishWords))];
+        text += Punctuation[random.Next(IM_ARRAYSIZE(Punctuation))];
+    }
+    return text;
+}
+
+static bool SameWidth(float a, float b)
+{
+    return fabsf(a - b) <= 1e-5f * ImMax(1.0f, fabsf(b));
+}
+
+// Lines of the corpus one after the other, as a wrapped text widget walks them
+static int WrapAll(const char* text, const char* end, float scale, bool reference, const ImFont* font)
+{
+    int lines = 0;
+    for (const char* s = text; s < end; ++lines)
+    {
+        const char* eol = reference ? RefWordWrapPosition(font, scale, s, end, WRAPWIDTH) : font->CalcWordWrapPositionA(scale, s, end, WRAPWIDTH);
+        s = eol > s ? eol : s + 1;
+        while (s < end && (ImCharIsBlankA(*s) || *s == '\n'))
+            ++s;
+    }
+    return lines;
+}
+
+static bool RunCorpus(const char* label, const std::string& corpus, const ImFont* font, BenchRandom& random)
+{
+    const char* text = corpus.data();
+    const char* end = text + corpus.size();
+    const float scale = FONTSIZE / font->FontSize;
+
+    ImVec2 size, refSize, wrapped, refWrapped;
+    int lines = 0, refLines = 0;
+    double sizeMs = BenchBest(6, [&]() { size = font->CalcTextSizeA(FONTSIZE, FLT_MAX, 0.0f, text, end); });
+    double refSizeMs = BenchBest(6, [&]() { refSize = RefTextSize(font, FONTSIZE, FLT_MAX, 0.0f, text, end, NULL); });
+    double wrappedMs = BenchBest(6, [&]() { wrapped = font->CalcTextSizeA(FONTSIZE, FLT_MAX, WRAPWIDTH, text, end); });
+    double refWrappedMs = BenchBest(6, [&]() { refWrapped = RefTextSize(font, FONTSIZE, FLT_MAX, WRAPWIDTH, text, end, NULL); });
+    double wrapMs = BenchBest(6, [&]() { lines = WrapAll(text, end, scale, false, font); });
+    double refWrapMs = BenchBest(6, [&]() { refLines = WrapAll(text, end, scale, true, font); });
+
+    bool ok = SameWidth(size.x, refSize.x) && size.y == refSize.y && SameWidth(wrapped.x, refWrapped.x) && wrapped.y == refWrapped.y && lines == refLines;
+
+    // random slices, widths and max widths: the wrap position and where a max width stops must be the same
+    int mismatches = 0;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const int begin = (int)random.Next((unsigned int)corpus.size() - 512);
+        const char* s = text + begin;
+        const char* e = s + 1 + random.Next(511);
+        const float wrapWidth = 20.0f + (float)random.Next(800);
+        // half pixels: with the default font every advance is 7 * 16 / 13, and a max width exactly on a multiple of it
+        // would be a tie the two summation orders may round either way
+        const float maxWidth = i % 2 ? FLT_MAX : 10.5f + (float)random.Next(1500);
+        const char* remaining = NULL;
+        const char* refRemaining = NULL;
+        ImVec2 a = font->CalcTextSizeA(FONTSIZE, maxWidth, i % 4 < 2 ? wrapWidth : 0.0f, s, e, &remaining);
+        ImVec2 b = RefTextSize(font, FONTSIZE, maxWidth, i % 4 < 2 ? wrapWidth : 0.0f, s, e, &refRemaining);
+        if (!SameWidth(a.x, b.x) || a.y != b.y || remaining != refRemaining
+            || font->CalcWordWrapPositionA(scale, s, e, wrapWidth) != RefWordWrapPosition(font, scale, s, e, wrapWidth))
+            ++mismatches;
+    }
+    ok &= mismatches == 0;
+
+    printf("%s, %.1f MB\n", label, corpus.size() / (1024.0 * 1024.0));
+    printf("  %-16s %10s %10s %8s\n", "", "ms", "ref ms", "speedup");
+    printf("  %-16s %10.3f %10.3f %7.2fx\n", "size", sizeMs, refSizeMs, refSizeMs / sizeMs);
+    printf("  %-16s %10.3f %10.3f %7.2fx\n", "wrapped size", wrappedMs, refWrappedMs, refWrappedMs / wrappedMs);
+    printf("  %-16s %10.3f %10.3f %7.2fx   %d lines\n", "wrap positions", wrapMs, refWrapMs, refWrapMs / wrapMs, lines);
+    printf("  %d sampled slices, %d mismatches%s\n", SAMPLES, mismatches, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+int main()
+{
+    BenchCreateContext(1280.0f, 720.0f);
+    const ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+
+    BenchRandom random(41);
+    bool ok = RunCorpus("English", MakeCorpus(random, false), font, random);
+    ok &= RunCorpus("mixed CJK / English", MakeCorpus(random, true), font, random);
+    ImGui::DestroyContext();
+
+    if (!ok)
+        printf("FAILED: the fast path and the reference loops disagree\n");
+    return ok ? 0 : 1;
+}
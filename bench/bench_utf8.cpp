@@ -0,0 +1,252 @@
+// Benchmark of the UTF-8 / ImWchar transcoders (ImTextStrFromUtf8, ImTextCountCharsFromUtf8,
+// ImTextStrToUtf8, ImTextCountUtf8BytesFromStr) on ASCII, Latin-1 and CJK text, against the
+// one-character-at-a-time loops they had before converting ASCII runs 16 at a time, kept below as
+// the reference. The outputs are checked against the reference on the corpora and on random
+// slices, buffer sizes and invalid UTF-8.
+
+#include "bench.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+static const int CORPUSBYTES = 16 * 1024 * 1024;
+static const int SAMPLES = 200000;
+
+static const char* const AsciiWords[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "markdown", "preview", "editor", "paragraph",
+};
+static const char* const Latin1Words[] = {
+    "caf\xc3\xa9", "na\xc3\xafve", "gr\xc3\xbc\xc3\x9f" "e", "se\xc3\xb1or", "\xc3\xa0", "fa\xc3\xa7" "ade", "\xc3\xa9t\xc3\xa9",
+    "le", "de", "la", "und", "el", "pr\xc3\xa9" "face",
+};
+static const char* const CjkWords[] = {
+    "\xe4\xb8\xad\xe6\x96\x87", "\xe6\x96\x87\xe6\xa1\xa3", "\xe9\xa2\x84\xe8\xa7\x88", "\xe7\xbc\x96\xe8\xbe\x91\xe5\x99\xa8",
+    "\xe6\xae\xb5\xe8\x90\xbd", "\xef\xbc\x8c", "\xe3\x80\x82", "\xe3\x81\xae\xe3\x81\xa7\xe3\x81\x99",
+};
+
+// ImTextStrFromUtf8 before the block path
+static int RefStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
+{
+    ImWchar* buf_out = buf;
+    ImWchar* buf_end = buf + buf_size;
+    while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        *buf_out++ = (ImWchar)c;
+    }
+    *buf_out = 0;
+    if (in_text_remaining)
+        *in_text_remaining = in_text;
+    return (int)(buf_out - buf);
+}
+
+// ImTextCountCharsFromUtf8 before the block path
+static int RefCountCharsFromUtf8(const char* in_text, const char* in_text_end)
+{
+    int char_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        char_count++;
+    }
+    return char_count;
+}
+
+static int RefCharToUtf8(char* buf, int buf_size, unsigned int c)
+{
+    if (c < 0x80)
+    {
+        buf[0] = (char)c;
+        return 1;
+    }
+    if (c < 0x800)
+    {
+        if (buf_size < 2) return 0;
+        buf[0] = (char)(0xc0 + (c >> 6));
+        buf[1] = (char)(0x80 + (c & 0x3f));
+        return 2;
+    }
+    if (c < 0x10000)
+    {
+        if (buf_size < 3) return 0;
+        buf[0] = (char)(0xe0 + (c >> 12));
+        buf[1] = (char)(0x80 + ((c >> 6) & 0x3f));
+        buf[2] = (char)(0x80 + ((c ) & 0x3f));
+        return 3;
+    }
+    if (c <= 0x10FFFF)
+    {
+        if (buf_size < 4) return 0;
+        buf[0] = (char)(0xf0 + (c >> 18));
+        buf[1] = (char)(0x80 + ((c >> 12) & 0x3f));
+        buf[2] = (char)(0x80 + ((c >> 6) & 0x3f));
+        buf[3] = (char)(0x80 + ((c ) & 0x3f));
+        return 4;
+    }
+    return 0;
+}
+
+// ImTextStrToUtf8 before the block path
+static int RefStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, const ImWchar* in_text_end)
+{
+    char* buf_p = out_buf;
+    const char* buf_end = out_buf + out_buf_size;
+    while (buf_p < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c = (unsigned int)(*in_text++);
+        if (c < 0x80)
+            *buf_p++ = (char)c;
+        else
+            buf_p += RefCharToUtf8(buf_p, (int)(buf_end - buf_p - 1), c);
+    }
+    *buf_p = 0;
+    return (int)(buf_p - out_buf);
+}
+
+// ImTextCountUtf8BytesFromStr before the block path
+static int RefCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end)
+{
+    int bytes_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c = (unsigned int)(*in_text++);
+        if (c < 0x80) bytes_count++;
+        else if (c < 0x800) bytes_count += 2;
+        else if (c < 0x10000) bytes_count += 3;
+        else if (c <= 0x10FFFF) bytes_count += 4;
+        else bytes_count += 3;
+    }
+    return bytes_count;
+}
+
+static std::string MakeCorpus(BenchRandom& random, const char* const* words, int wordCount)
+{
+    std::string text;
+    text.reserve(CORPUSBYTES + 64);
+    while ((int)text.size() < CORPUSBYTES)
+    {
+        text += words[random.Next(wordCount)];
+        int r = random.Next(20);
+        text += r == 0 ? "\n" : r == 1 ? ", " : " ";
+    }
+    return text;
+}
+
+static bool RunCorpus(const char* label, const std::string& corpus)
+{
+    const char* text = corpus.data();
+    const char* end = text + corpus.size();
+    std::vector<ImWchar> wide(corpus.size() + 1), refWide(corpus.size() + 1);
+    std::vector<char> narrow(corpus.size() * 2 + 1), refNarrow(corpus.size() * 2 + 1);
+
+    int chars = 0, refChars = 0, count = 0, refCount = 0, bytes = 0, refBytes = 0, byteCount = 0, refByteCount = 0;
+    double fromMs = BenchBest(5, [&]() { chars = ImTextStrFromUtf8(wide.data(), (int)wide.size(), text, end); });
+    double refFromMs = BenchBest(5, [&]() { refChars = RefStrFromUtf8(refWide.data(), (int)refWide.size(), text, end, NULL); });
+    double countMs = BenchBest(5, [&]() { count = ImTextCountCharsFromUtf8(text, end); });
+    double refCountMs = BenchBest(5, [&]() { refCount = RefCountCharsFromUtf8(text, end); });
+    const ImWchar* wideEnd = refWide.data() + refChars;
+    double toMs = BenchBest(5, [&]() { bytes = ImTextStrToUtf8(narrow.data(), (int)narrow.size(), refWide.data(), wideEnd); });
+    double refToMs = BenchBest(5, [&]() { refBytes = RefStrToUtf8(refNarrow.data(), (int)refNarrow.size(), refWide.data(), wideEnd); });
+    double bytesMs = BenchBest(5, [&]() { byteCount = ImTextCountUtf8BytesFromStr(refWide.data(), wideEnd); });
+    double refBytesMs = BenchBest(5, [&]() { refByteCount = RefCountUtf8BytesFromStr(refWide.data(), wideEnd); });
+
+    bool ok = chars == refChars && memcmp(wide.data(), refWide.data(), (chars + 1) * sizeof(ImWchar)) == 0
+        && count == refCount && count == refChars
+        && bytes == refBytes && memcmp(narrow.data(), refNarrow.data(), bytes + 1) == 0 && bytes == (int)corpus.size()
+        && byteCount == refByteCount && byteCount == bytes;
+
+    const size_t wideBytes = refChars * sizeof(ImWchar);
+    printf("%s, %.1f MB, %d chars\n", label, corpus.size() / (1024.0 * 1024.0), refChars);
+    printf("  %-16s %10s %10s %8s\n", "", "MB/s", "ref MB/s", "speedup");
+    printf("  %-16s %10.0f %10.0f %7.2fx\n", "from UTF-8", BenchMBps(corpus.size(), fromMs), BenchMBps(corpus.size(), refFromMs), refFromMs / fromMs);
+    printf("  %-16s %10.0f %10.0f %7.2fx\n", "count chars", BenchMBps(corpus.size(), countMs), BenchMBps(corpus.size(), refCountMs), refCountMs / countMs);
+    printf("  %-16s %10.0f %10.0f %7.2fx\n", "to UTF-8", BenchMBps(wideBytes, toMs), BenchMBps(wideBytes, refToMs), refToMs / toMs);
+    printf("  %-16s %10.0f %10.0f %7.2fx%s\n", "count bytes", BenchMBps(wideBytes, bytesMs), BenchMBps(wideBytes, refBytesMs), refBytesMs / bytesMs, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+// Random UTF-8, well-formed or not: ASCII runs, 2 to 4 byte characters, stray and truncated
+// sequences, and the odd NUL
+static void MakeBytes(BenchRandom& random, std::string& text)
+{
+    text.clear();
+    const int length = random.Next(80);
+    while ((int)text.size() < length)
+    {
+        int r = random.Next(16);
+        if (r < 6)
+            for (int i = 1 + random.Next(24); i > 0; --i)
+                text += (char)(' ' + random.Next(95));
+        else if (r < 8)
+            text += Latin1Words[random.Next(IM_ARRAYSIZE(Latin1Words))];
+        else if (r < 10)
+            text += CjkWords[random.Next(IM_ARRAYSIZE(CjkWords))];
+        else if (r == 10)
+            text += "\xf0\x9f\x98\x80";
+        else if (r == 11)
+            text += (char)(0x80 + random.Next(128));
+        else if (r == 12)
+            text += "\xe4\xb8";
+        else if (r == 13)
+            text += "\xed\xa0\x80";
+        else if (r == 14 && random.Next(4) == 0)
+            text += '\0';
+        else
+            text += (char)random.Next(256);
+    }
+}
+
+// Random slices of random input, with random buffer sizes, with and without an end
+static int CheckSamples(BenchRandom& random)
+{
+    std::string text;
+    ImWchar wide[128], refWide[128];
+    char narrow[512], refNarrow[512];
+    int mismatches = 0;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        MakeBytes(random, text);
+        const char* begin = text.c_str();
+        const char* end = i % 3 == 0 ? NULL : begin + text.size();
+        const int wideSize = 1 + random.Next(IM_ARRAYSIZE(wide));
+        const char* remaining = NULL;
+        const char* refRemaining = NULL;
+        int chars = ImTextStrFromUtf8(wide, wideSize, begin, end, &remaining);
+        int refChars = RefStrFromUtf8(refWide, wideSize, begin, end, &refRemaining);
+        bool same = chars == refChars && remaining == refRemaining && memcmp(wide, refWide, (chars + 1) * sizeof(ImWchar)) == 0
+            && ImTextCountCharsFromUtf8(begin, end) == RefCountCharsFromUtf8(begin, end);
+
+        // back to UTF-8, into a buffer that may cut a character
+        const ImWchar* wideEnd = i % 3 == 1 ? NULL : refWide + refChars;
+        const int narrowSize = 1 + random.Next(IM_ARRAYSIZE(narrow));
+        int bytes = ImTextStrToUtf8(narrow, narrowSize, refWide, wideEnd);
+        int refBytes = RefStrToUtf8(refNarrow, narrowSize, refWide, wideEnd);
+        same &= bytes == refBytes && memcmp(narrow, refNarrow, bytes + 1) == 0
+            && ImTextCountUtf8BytesFromStr(refWide, wideEnd) == RefCountUtf8BytesFromStr(refWide, wideEnd);
+        mismatches += same ? 0 : 1;
+    }
+    return mismatches;
+}
+
+int main()
+{
+    BenchRandom random(50);
+    bool ok = RunCorpus("ASCII", MakeCorpus(random, AsciiWords, IM_ARRAYSIZE(AsciiWords)));
+    ok &= RunCorpus("Latin-1", MakeCorpus(random, Latin1Words, IM_ARRAYSIZE(Latin1Words)));
+    ok &= RunCorpus("CJK", MakeCorpus(random, CjkWords, IM_ARRAYSIZE(CjkWords)));
+
+    int mismatches = CheckSamples(random);
+    printf("%d random samples, %d mismatches\n", SAMPLES, mismatches);
+    ok &= mismatches == 0;
+
+    if (!ok)
+        printf("FAILED: the transcoders and the reference loops disagree\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef _DOCUMENTSEARCH_H
+#define _DOCUMENTSEARCH_H
+
+#include <string>
+#include "MarkdownDocument.h"
+#include "TrigramIndex.h"
+
+// Ctrl+F search over a document. The trigram index is built the first time a query runs and is
+// then kept up to date edit by edit, so a query only verifies the few chunks that can match.
+// Results go to doc.matches, which the editor and the preview tint.
+struct DocumentSearch {
+    DocumentSearch() : caseSensitive(false), open(false), focus(false) { query[ 0 ] = 0; }
+
+    // Call after every change of the document text
+    void    OnEdit( const ImGui::MarkdownEdit& edit_, ImGui::MarkdownDocument& doc_ );
+    void    OnReload( ImGui::MarkdownDocument& doc_ );
+    // Search bar window, opened with Ctrl+F. Enter / F3 go to the next match, Shift for the previous one.
+    void    Show( ImGui::MarkdownDocument& doc_ );
+    // The index is only a cache: once dropped it is built again by the next query
+    size_t  IndexBytes() const { return index.Bytes(); }
+    void    DropIndex() { index.Clear(); }
+
+    static const int MAXMATCHES = 100000;
+
+private:
+    void    Run( ImGui::MarkdownDocument& doc_ );
+    void    Select( ImGui::MarkdownDocument& doc_, int match_ );
+
+    TrigramIndex    index;
+    char            query[ 256 ];
+    std::string     lastQuery;          // query the current results are for
+    bool            caseSensitive;
+    bool            open;
+    bool            focus;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef _DOCUMENTTABS_H
+#define _DOCUMENTTABS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "MarkdownDocument.h"
+#include "EditJournal.h"
+#include "DocumentSearch.h"
+#include "UndoHistory.h"
+#include "PasteJob.h"
+
+// A note open in a tab: its text, parse model and block caches, autosave journal, undo history, pending paste and search
+struct OpenDocument {
+    std::string                 path;               // empty for an untitled document
+    ImGui::MarkdownDocument     doc;
+    EditJournal                 journal;
+    UndoHistory                 undo;
+    PasteJob                    paste;              // large paste on its way into the editor
+    DocumentSearch              search;
+    int                         lastFrame = 0;      // last frame the document was the active one
+};
+
+// The open notes, one editor tab each; the preview, the outline and the search bar follow the
+// active tab. Fonts and image textures are shared by all documents. What a document derives from
+// its text (blocks, line index, block caches, committed copy, search index) is only a cache, and
+// counts with the undo history against CACHEBUDGET: over it, the least recently active documents
+// unload theirs, then lose their oldest undo steps, so an open document costs about its text.
+struct DocumentTabs {
+    DocumentTabs() : active( -1 ), select( -1 ) {}
+    ~DocumentTabs() { CloseAll(); }
+
+    // Opens path_ in a new tab, autosaved by its journal, or selects its tab if it is open already.
+    // Returns NULL when the file cannot be opened.
+    OpenDocument*   Open( const char* path_ );
+    // Document without a journal: untitled when path_ is NULL, or a file that is only viewed (tail mode)
+    OpenDocument*   Add( const char* path_ );
+    OpenDocument*   Active() { return active >= 0 ? docs[ active ].get() : NULL; }
+    void            CloseAll();
+
+    // Editor window, one tab per document
+    void            ShowEditor();
+    // Call once per frame: autosaves, and enforces the cache budget
+    void            Update();
+    // Sum of the documents' running totals and undo histories, cheap enough to check every frame
+    size_t          CacheBytes() const;
+
+    static const size_t     CACHEBUDGET = 64 * 1024 * 1024;
+    static const int        TEXTUREIDLEFRAMES = 600;      // image textures not drawn for this long are freed
+
+    std::vector<std::unique_ptr<OpenDocument>> docs;
+
+private:
+    void            Close( int index_ );
+    void            Trim();
+
+    int             active;
+    int             select;             // tab to bring to front on the next frame
+};
+
+#endif
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef _EDITJOURNAL_H
+#define _EDITJOURNAL_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include "MarkdownDocument.h"
+
+// Crash-safe autosave.
+// Every edit is appended to "<path>.journal" as a compact insert/delete record, so a keystroke
+// costs a few bytes of I/O whatever the size of the document. A background thread writes the
+// records and fsyncs them in batches. From time to time the journal is compacted: the whole text
+// is written to "<path>.tmp" and renamed over <path>, then the journal starts again empty.
+// After a crash, Open() loads <path> and replays the journal on top of it.
+//
+// Journal layout: "MDJ1", base length (u64), base hash (u64), then records
+//   op ('+' insert, '-' delete), varint pos, varint length, [inserted bytes], FNV-1a 32 checksum
+// A journal whose base does not match <path> is stale (crash during compaction) and is ignored.
+// When the journal cannot be started again after a snapshot, records stop being written (they
+// would go to a journal Open() throws away) and a full snapshot is written on the next Update().
+struct EditJournal {
+    EditJournal() : journalFd(-1), stop(false), resetFailed(false), opened(false), failed(false), pendingBytes(0), lastEditTime(0.0), lastSnapshotTime(0.0) {}
+    ~EditJournal() { Close( NULL, 0 ); }
+
+    // Loads the document (recovering unsaved edits) into doc_ and starts the writer thread
+    bool    Open( const char* path_, ImGui::MarkdownDocument& doc_ );
+    // Writes a final snapshot when text_ is given, then stops the writer thread
+    void    Close( const char* text_, int length_ );
+    bool    IsOpen() const { return opened; }
+    // The journal could not be restarted after a snapshot: edits are not on disk until a snapshot succeeds
+    bool    Failed() const { return failed; }
+
+    void    Record( const ImGui::MarkdownEdit& edit_, const char* text_ );
+    // Call once per frame: schedules a compaction when the journal grew large or the editor is idle
+    void    Update( const char* text_, int length_ );
+
+    static const int        COMPACTBYTES = 4 * 1024 * 1024;   // journal size that forces a snapshot
+    static constexpr double IDLESECONDS = 5.0;                // snapshot after this long without edits...
+    static constexpr double SNAPSHOTSECONDS = 60.0;           // ...but not more often than this
+    static constexpr double BATCHSECONDS = 0.25;              // records are written and synced together
+    static constexpr double RETRYSECONDS = 5.0;               // a failed snapshot is tried again after this long
+
+private:
+    struct Job {
+        std::string records;
+        std::string snapshot;
+        bool        isSnapshot = false;
+    };
+
+    void    WorkerMain();
+    void    Snapshot( const char* text_, int length_ );
+    bool    WriteSnapshot( const std::string& text_ );
+    bool    ResetJournal( const char* base_, size_t length_ );
+
+    std::string             path;
+    std::string             journalPath;
+    int                     journalFd;          // owned by the writer thread once it runs
+
+    std::mutex              mutex;
+    std::condition_variable cond;
+    std::thread             worker;
+    std::vector<Job>        jobs;
+    bool                    stop;
+    std::atomic<bool>       resetFailed;        // set by the writer thread: journalFd is closed until a snapshot succeeds
+
+    // main thread only
+    bool                    opened;
+    bool                    failed;
+    long long               pendingBytes;       // record bytes since the last snapshot
+    double                  lastEditTime;
+    double                  lastSnapshotTime;
+};
+
+#endif
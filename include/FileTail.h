@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef _FILETAIL_H
+#define _FILETAIL_H
+
+#include <string>
+#include "imgui.h"
+
+// Follows a file that keeps growing (like `tail -f`).
+// On Linux the file is watched with inotify, so Poll() is a single non-blocking read
+// when nothing changed and otherwise only reads the bytes appended since the last call.
+struct FileTail {
+    enum PollResult {
+        NONE,
+        APPENDED,                       // new bytes were appended to out_
+        RELOADED,                       // file was truncated or replaced, out_ holds its whole content
+    };
+
+    FileTail() : fd(-1), watchFd(-1), offset(0) {}
+    ~FileTail() { Close(); }
+
+    bool        Open( const char* path_ );
+    void        Close();
+    bool        IsOpen() const { return fd >= 0; }
+    PollResult  Poll( ImVector<char>& out_ );
+
+private:
+    bool        ReadNew( ImVector<char>& out_ );
+
+    std::string path;
+    int         fd;
+    int         watchFd;                // inotify instance, -1 when polling with fstat
+    long long   offset;                 // bytes already handed out
+};
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef _FOLDERSEARCH_H
+#define _FOLDERSEARCH_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+// "Search all notes": finds a string in every .md file under a folder.
+// The folder walk and every file are tasks on the shared ThreadPool. A file is mapped and
+// scanned with SSE2 (16 candidate positions per compare). Each file's hits are pushed on a
+// lock-free queue that the UI drains every frame, so results appear while the search runs.
+// Changing the query starts a new generation: running tasks notice it and stop, and whatever
+// they still publish is dropped.
+struct FolderSearch {
+    struct Hit {
+        int     file;                       // index in files
+        int     line;                       // 1-based
+        int     offset;                     // byte offset of the match in the file
+        int     snippetStart;               // line text in snippets
+        int     snippetLength;
+    };
+
+    FolderSearch();
+    ~FolderSearch();
+
+    void    SetFolder( const char* folder_ );
+    void    Start( const char* folder_, const char* query_, bool caseSensitive_ );
+    void    Cancel();
+    bool    IsRunning() const;
+    // Moves the published results to files / hits; call once per frame
+    void    Drain();
+
+    // Search panel, Ctrl+Shift+F jumps to its query box. Returns the hit that was clicked, NULL otherwise
+    const Hit* Show();
+
+    static const int MAXHITS = 1000000;
+    static const int MAXSNIPPET = 160;
+
+    std::vector<std::string>    files;
+    std::vector<Hit>            hits;
+    std::string                 snippets;
+
+    struct Shared;
+private:
+    std::shared_ptr<Shared>     shared;         // also held by the running tasks
+    char                        folder[ 512 ];
+    char                        query[ 256 ];
+    bool                        caseSensitive;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef _HTMLEXPORT_H
+#define _HTMLEXPORT_H
+
+#include <string>
+#include "MarkdownDocument.h"
+
+// Markdown to HTML with the block model of the preview: headings, fenced code (highlighted by the
+// same lexer), pipe tables, and the line syntax of the renderer for the rest (lists, indents,
+// rules, links, images, emphasis).
+// Blocks are independent, so the document is cut into ranges of about HTMLRANGEBYTES of source that
+// are rendered on the ThreadPool; the pieces are then written out with one writev().
+
+// Appends the HTML of blocks [fromBlock_, toBlock_) to out_
+void RenderHtmlBlocks( const ImGui::MarkdownDocument& doc_, int fromBlock_, int toBlock_, std::string& out_ );
+// Writes doc_ as a standalone page to path_. Returns false if the file cannot be written.
+bool ExportHtml( const ImGui::MarkdownDocument& doc_, const char* path_, const char* title_ );
+// Reads and parses mdPath_, then exports it to htmlPath_
+bool ExportHtmlFile( const char* mdPath_, const char* htmlPath_ );
+
+static const int HTMLRANGEBYTES = 256 * 1024;
+
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+#ifndef _LINKLAUNCHER_H
+#define _LINKLAUNCHER_H
+
+// Opens links with the desktop handler (xdg-open / ShellExecute) on a worker thread.
+// The URL is passed as a single argv entry, never through a shell, and the frame loop never
+// waits for the handler: OpenLinkAsync() only queues the request.
+void OpenLinkAsync( const char* url_, int length_ );
+
+// Draws a small overlay with the links being opened and the ones that failed to open
+void ShowLinkStatus();
+
+#endif
@@ -3,12 +3,21 @@
 #ifndef _LOADIMAGE_H
 #define _LOADIMAGE_H
 
+#include "imgui.h"
 
-typedef unsigned int GLuint;
+// Textures are created by the renderer in use: OpenGL by default, unless built with
+// LOADIMAGE_NO_OPENGL (headless renderer), whose software rasterizer installs its own.
+typedef ImTextureID (*CreateTextureFunc)(const unsigned char* rgba, int width, int height);
+typedef void (*DestroyTextureFunc)(ImTextureID texture);
+void SetTextureFunctions(CreateTextureFunc create, DestroyTextureFunc destroy);
 
-#define GL_CLAMP_TO_EDGE 0x812F
+bool LoadTextureFromFile(const char* filename, ImTextureID* out_texture, int* out_width, int* out_height);
 
-
-bool LoadTextureFromFile(const char* filename, GLuint* out_texture, int* out_width, int* out_height);
+// Textures of image files, loaded on first use and shared by every open document.
+// A file that cannot be loaded is remembered too, so it is not read again every frame.
+bool GetCachedTexture(const char* filename, ImTextureID* out_texture, int* out_width, int* out_height);
+// Call once per frame: frees the textures no document has drawn for idle_frames frames
+void CollectTextures(int idle_frames);
+void ReleaseTextures();
 
 #endif
@@ -0,0 +1,188 @@
+#pragma once
+
+#ifndef _MARKDOWNDOCUMENT_H
+#define _MARKDOWNDOCUMENT_H
+
+#include <vector>
+#include "imgui_markdown.h"
+#include "SyntaxHighlight.h"
+
+namespace ImGui {
+
+    enum class MarkdownBlockType {
+        TEXT,                           // run of paragraph / list lines, ends after a blank line
+        HEADING,
+        CODE,                           // fenced code block, from the opening to the closing fence
+        TABLE,                          // pipe table: header row, delimiter row, body rows
+    };
+
+    // A range of whole lines of the source. Blocks are the unit of parsing and of layout:
+    // only the blocks that intersect the visible area are submitted to ImGui each frame.
+    struct MarkdownBlock {
+        MarkdownBlockType type  = MarkdownBlockType::TEXT;
+        int     start           = 0;        // offset of the first byte of the block
+        int     stop            = 0;        // offset one past the last byte (including its '\n')
+        int     lineCount       = 0;
+        int     level           = 0;        // set for headings: 1 for H1, 2 for H2 etc.
+        int     contentStart    = 0;        // code blocks: text between the fences
+        int     contentStop     = 0;
+        int     cache           = -1;       // index in MarkdownDocument::caches, -1 until first shown
+        float   height          = 0.0f;     // estimated until measured is true
+        float   posY            = 0.0f;     // offset from the top of the document
+        bool    measured        = false;
+    };
+
+    // Entry of the document outline, kept up to date by the parser
+    struct MarkdownHeading {
+        int     level           = 0;
+        int     textStart       = 0;        // heading text without the '#' markers
+        int     textStop        = 0;
+        int     block           = 0;        // index in MarkdownDocument::blocks, whose posY is the cached y position
+    };
+
+    // Data derived from the text of one block, built the first time the block is shown and kept
+    // until the block is re-parsed, so unchanged blocks cost nothing to rebuild on later frames.
+    struct MarkdownBlockCache {
+        // code blocks: highlighted runs (offsets from contentStart) and where each line's runs begin
+        ImVector<SyntaxRun>     runs;
+        ImVector<int>           lineRuns;
+        ImVector<float>         runX;               // x offset of each run for font / fontSize
+        // tables: start and stop offset (from block start) of every cell, row after row, columns cells per row
+        ImVector<int>           cells;
+        ImVector<char>          align;              // per column: 'l', 'c' or 'r'
+        ImVector<float>         columnWidths;       // measured over all rows for font / fontSize
+        int                     columns = 0;
+        ImFont*                 font = NULL;
+        float                   fontSize = 0.0f;
+
+        void Clear() { runs.clear(); lineRuns.clear(); runX.clear(); cells.clear(); align.clear(); columnWidths.clear(); columns = 0; font = NULL; fontSize = 0.0f; }
+        size_t Bytes() const
+        {
+            return (size_t)runs.Capacity * sizeof( SyntaxRun ) + (size_t)lineRuns.Capacity * sizeof( int ) + (size_t)runX.Capacity * sizeof( float )
+                + (size_t)cells.Capacity * sizeof( int ) + (size_t)align.Capacity + (size_t)columnWidths.Capacity * sizeof( float );
+        }
+    };
+
+    // Editor coloring state at the start of a line. Only code fences span lines (emphasis, links and
+    // code spans are colored within their line), so this is all that carries over from one line to the next.
+    struct MarkdownLineState {
+        const SyntaxLanguage*   lang = NULL;        // language of the open fence
+        int     fence           = 0;                // length of the open code fence, 0 outside code blocks
+        char    fenceChar       = 0;
+        int     code            = 0;                // HighlightLine() state inside the fence
+
+        bool    operator==( const MarkdownLineState& other_ ) const { return lang == other_.lang && fence == other_.fence && fenceChar == other_.fenceChar && code == other_.code; }
+    };
+
+    // Appends the colored runs of one source line (offsets relative to base_) and advances state_ to the next line
+    void HighlightMarkdownLine( const char* base_, const char* line_, const char* lineEnd_, MarkdownLineState* state_, ImVector<SyntaxRun>& runs_ );
+
+    // A single contiguous change: deleteLength bytes at pos were replaced by insertLength bytes
+    struct MarkdownEdit {
+        int     pos             = 0;
+        int     deleteLength    = 0;
+        int     insertLength    = 0;
+        bool    IsEmpty() const { return deleteLength == 0 && insertLength == 0; }
+    };
+
+    // Smallest single edit that turns old_ into new_ (common prefix and suffix are skipped). sameHead_ and
+    // sameTail_ are bytes at the start and at the end already known to be equal: only the rest is compared.
+    MarkdownEdit DiffText( const char* old_, int oldLength_, const char* new_, int newLength_, int sameHead_ = 0, int sameTail_ = 0 );
+
+    // Retained document model: the source text and its block index, plus the cached block
+    // heights used to virtualize the preview.
+    // - Append() only re-parses the trailing block and the new bytes, so tailing a growing
+    //   file costs in proportion to what was appended.
+    // - buf is NUL terminated and can be handed directly to InputTextMultiline. It is always
+    //   exactly Length() + 1 bytes: an editor writing into it resizes it to the text (see
+    //   MarkdownEditor()). When trackEdits is set, CommitEdit() finds what the widget changed
+    //   and re-parses only around it.
+    struct MarkdownDocument {
+        static const int        MAXBLOCKLINES = 64;     // split long paragraphs so layout stays fine grained
+
+        ImVector<char>          buf;
+        ImVector<MarkdownBlock> blocks;
+        float                   layoutWidth = 0.0f;     // content width the measured heights are valid for
+        float                   layoutFontSize = 0.0f;  // font size the measured heights are valid for
+        float                   totalHeight = 0.0f;
+        int                     layoutDirty = 0;        // first block whose posY is out of date
+        bool                    autoScroll  = false;    // follow the end of the document while scrolled to the bottom
+        bool                    trackEdits  = false;
+        bool                    unloaded    = false;    // only buf is kept, see Unload()
+        ImVector<char>          committed;              // copy of buf as of the last CommitEdit(), when trackEdits
+        std::vector<MarkdownBlockCache> caches;
+        ImVector<int>           freeCaches;
+        size_t                  cacheBytes  = 0;        // sum of caches[].Bytes(), kept up to date by whoever fills or clears one
+        ImVector<MarkdownHeading> headings;
+        float                   viewTop     = 0.0f;     // first visible y of the preview, in posY units
+        int                     scrollToBlock = -1;     // set to scroll the preview to a block on the next frame
+        // scroll sync: the editor or the preview, whichever the user scrolls, sets the line the other one shows at its top
+        float                   previewSyncLine = -1.0f;
+        float                   editorSyncLine = -1.0f;
+        float                   editorScrollY = 0.0f;   // editor scroll of the last frame
+        ImVector<int>           lineStarts;             // offset of the first byte of every line
+        ImVector<MarkdownLineState> lineStates;         // editor coloring: state at the start of every line
+        int                     statesKnown = 1;        // lines [0, statesKnown) have exact states
+        int                     statesCached = 0;       // [statesKnown, statesCached) are from before the last edits, exact
+        int                     statesEditEnd = 0;      // again once re-tokenizing past statesEditEnd gives the same state
+        ImVector<int>           matches;                // search results: sorted offsets of matchLength long matches
+        int                     matchLength = 0;
+        int                     currentMatch = -1;
+        bool                    revealMatch = false;    // set to scroll the editor to currentMatch on the next frame
+
+        MarkdownDocument() { buf.push_back( 0 ); lineStarts.push_back( 0 ); lineStates.push_back( MarkdownLineState() ); }
+
+        int         Length() const { return buf.Size > 0 ? buf.Size - 1 : 0; }
+        const char* Text() const { return buf.Data; }
+
+        void        SetText( const char* text_, size_t length_ );
+        // Committed copy, line index and blocks of the whole of buf
+        void        Derive();
+        void        Append( const char* text_, size_t length_ );
+        void        Parse( int fromBlock_ = 0 );
+        void        Reparse( const MarkdownEdit& edit_ );
+        // deleted_ receives the bytes the edit removed. sameHead_ / sameTail_ bytes at the start / end are known
+        // to be unchanged (see DiffText()), so an editor that knows where it changed the text skips comparing the rest.
+        MarkdownEdit CommitEdit( ImVector<char>* deleted_ = NULL, int sameHead_ = 0, int sameTail_ = 0 );
+        int         FindBlockAt( int offset_ ) const;
+        void        UpdateLineStarts( const MarkdownEdit& edit_ );
+        int         FindLineAt( int offset_ ) const;
+        // Coloring state at the start of line_, tokenizing forward from the last known line as needed.
+        // After an edit only the lines from the edited one on are tokenized again, up to where the
+        // state is back to what it was before the edit; the states below are kept.
+        const MarkdownLineState& LineState( int line_ );
+        void        UpdateLayout( float lineHeight_ );
+        int         FindBlockAtY( float y_ ) const;
+        int         FindHeadingAtY( float y_ ) const;
+        // Source line <-> preview y. The blocks are sorted by both start offset and posY, so either way is
+        // a binary search, then a line interpolation inside one block: exact at block boundaries, and no
+        // layout is needed. Lines are fractional.
+        float       LineToY( float line_ ) const;
+        float       YToLine( float y_ ) const;
+        MarkdownBlockCache& GetCache( MarkdownBlock& block_ );
+        void        ReleaseCaches( int fromBlock_, int toBlock_ );
+        // Memory held by what is derived from the text: the block caches (a running total, not walked), the blocks and
+        // outline, the line index and coloring states, and the committed copy
+        size_t      CacheBytes() const;
+        // Frees the block caches (rebuilt as blocks are shown again)
+        void        DropCaches();
+        // Frees everything but the text, for a document that is not shown: Restore() derives it again (parsing the
+        // whole text) and must be called before the document is shown or edited. Restore() of a loaded document does nothing.
+        void        Unload();
+        void        Restore();
+        void        AddHeadings( int fromBlock_, int toBlock_ );
+    };
+
+    // Fill a block cache from the text alone: the highlighted runs of a code block, the cells and
+    // alignment of a table. Shared by the preview and the HTML export; safe to call from any thread.
+    void BuildCodeCache( const MarkdownDocument& doc_, const MarkdownBlock& block_, MarkdownBlockCache& cache_ );
+    void BuildTableCache( const MarkdownDocument& doc_, const MarkdownBlock& block_, MarkdownBlockCache& cache_ );
+
+    void RenderMarkdownDocument( MarkdownDocument& doc_, const MarkdownConfig& mdConfig_ );
+
+    // Heading list of the document; clicking one scrolls the preview to it using the cached
+    // block positions, so the content in between is never laid out
+    void RenderMarkdownOutline( MarkdownDocument& doc_ );
+}
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef _MARKDOWNEDITOR_H
+#define _MARKDOWNEDITOR_H
+
+#include "MarkdownDocument.h"
+#include "UndoHistory.h"
+#include "PasteJob.h"
+
+namespace ImGui {
+
+    // Multiline text editor over doc_.buf, which grows as needed, with the Markdown source colored
+    // (see HighlightMarkdownLine()). doc_.trackEdits must be set: a change is committed with
+    // doc_.CommitEdit() right away and returned, empty when the text did not change.
+    // The search matches of the document are tinted over the text, and doc_.revealMatch
+    // scrolls the current one into view. Scrolling the editor scrolls the preview of doc_ to the
+    // same source line, and the other way round (see MarkdownDocument::LineToY()).
+    // With undo_, every change is recorded there and Ctrl+Z / Ctrl+Y step through it instead of
+    // the small fixed size undo store of the widget; NULL keeps the widget's own.
+    // With paste_ as well, pasting PasteJob::LARGEBYTES or more runs in the background (see
+    // PasteJob): the editor stays usable meanwhile and the text is spliced in once it is ready.
+    MarkdownEdit MarkdownEditor( const char* label_, MarkdownDocument& doc_, UndoHistory* undo_, PasteJob* paste_, const ImVec2& size_ = ImVec2( 0, 0 ), ImGuiInputTextFlags flags_ = 0 );
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef _PASTEJOB_H
+#define _PASTEJOB_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include "MarkdownDocument.h"
+
+// Paste of a large clipboard text that does not block the UI.
+// The clipboard is copied on the main thread (the only one the platform lets read it) and a
+// ThreadPool task goes over the copy in CHUNKBYTES chunks, in parallel: invalid UTF-8 becomes
+// U+FFFD and the characters the editor widget would filter out are dropped, and every chunk is
+// also transcoded to the widget's ImWchar form. Once it is done, MarkdownEditor() splices both
+// forms into the text in one piece, and the paste is committed, journaled and undone as one edit.
+struct PasteJob {
+    PasteJob() : pos( 0 ), deleteLength( 0 ) {}
+    ~PasteJob() { Cancel(); }
+
+    // Copies text_ and starts filtering it; the result is to replace [pos_, pos_ + deleteLength_)
+    void    Start( const char* text_, size_t length_, int pos_, int deleteLength_, bool allowTabs_ );
+    bool    IsRunning() const { return work && !work->done; }
+    bool    IsReady() const { return work && work->done; }
+    float   Progress() const;
+    // Call for every change of the text while the job runs, so the paste lands where it was made
+    void    OnEdit( const ImGui::MarkdownEdit& edit_ );
+    // The filtered text, in UTF-8 and as ImWchar, once IsReady()
+    const std::string&          Text() const { return work->text; }
+    const std::vector<ImWchar>& Wide() const { return work->wide; }
+    // Ends the job once its text is spliced; a running task sees the cancel and stops
+    void    Finish() { work.reset(); }
+    void    Cancel();
+
+    int     pos;
+    int     deleteLength;
+
+    static const size_t LARGEBYTES = 256 * 1024;           // smaller pastes are left to the widget
+    static const int    CHUNKBYTES = 1024 * 1024;
+
+private:
+    struct Work {
+        std::string             source;
+        std::string             text;
+        std::vector<ImWchar>    wide;
+        bool                    allowTabs = false;
+        int                     chunkCount = 0;
+        std::atomic<int>        chunksDone{ 0 };
+        std::atomic<bool>       cancel{ false };
+        std::atomic<bool>       done{ false };
+    };
+
+    static void Run( const std::shared_ptr<Work>& work_ );
+
+    std::shared_ptr<Work>   work;           // also held by the running task
+};
+
+#endif
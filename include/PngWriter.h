@@ -0,0 +1,11 @@
+#pragma once
+
+#ifndef _PNGWRITER_H
+#define _PNGWRITER_H
+
+// Writes width_ x height_ RGBA pixels (4 bytes each, row after row) as an 8 bit RGBA PNG.
+// The image data is deflated with stored blocks: no compressor to link, at the cost of size,
+// which suits thumbnails and pixel exact comparisons. Returns false if the file cannot be written.
+bool WritePng( const char* path_, const unsigned char* rgba_, int width_, int height_ );
+
+#endif
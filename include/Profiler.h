@@ -0,0 +1,127 @@
+#pragma once
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+struct ImDrawData;
+
+// Subsystems measured by the scoped timers. Scopes nest (a line is drawn inside a block), so
+// their times are inclusive and do not add up to the frame time.
+enum ProfileScope {
+    PROFILE_MARKDOWN,       // ImGui::Markdown(): the text of one block
+    PROFILE_RENDERLINE,     // ImGui::RenderLine(): one line, with its wrapping
+    PROFILE_IMAGE,          // ImageCallback(): image lookup and sizing
+    PROFILE_LOADTEXTURE,    // LoadTextureFromFile(): decoding and upload
+    PROFILE_INPUTTEXT,      // the editor widget
+    PROFILE_GLRENDER,       // ImGui_ImplOpenGL3_RenderDrawData()
+    PROFILE_FONTBUILD,      // LoadFonts(): glyph ranges and atlas build
+    PROFILE_TASK,           // a ThreadPool task, on a worker
+    PROFILE_CHUNK,          // a chunk of ThreadPool::ParallelFor(), on any thread
+    PROFILE_COUNT
+};
+
+struct ProfileEvent {
+    long long   begin;      // nanoseconds, steady clock
+    long long   end;
+    int         scope;      // ProfileScope, or PROFILEFRAME
+    int         thread;     // small index given to each thread on its first event
+};
+
+static const int PROFILEFRAME = PROFILE_COUNT;  // whole frames, in traces only
+
+// Frame profiler: scoped timers on any thread push events into a lock-free ring, the main thread
+// drains it once per frame into per-frame totals, and the overlay shows their rolling p50/p99
+// with the number of ImGui allocations and of vertices and indices of every frame.
+// The same events can be recorded to a Chrome trace-event JSON file (chrome://tracing, Perfetto)
+// with a track per thread, workers included. They are written out every TRACECHUNK events, so a
+// long trace costs disk space, not memory.
+// While neither the overlay nor a trace is on, a timer costs one load and one branch.
+struct Profiler {
+    static Profiler& Shared();
+
+    // Counts the allocations of Dear ImGui (draw lists, ImVector...); call before CreateContext()
+    static void InstallAllocator();
+
+    static long long Now();
+    // Called by ProfileTimer from any thread
+    void    Record( int scope_, long long begin_, long long end_ );
+
+    // Call at the start of every frame, and after Render() with its draw data
+    void    NewFrame();
+    void    EndFrame( const ImDrawData* drawData_ );
+    // Overlay window; F12 toggles it, Shift+F12 starts and stops a trace to trace-<time>.json
+    void    Show();
+
+    // Recording to path_, false if it cannot be created; StopTrace() completes the file. Also usable
+    // without frames (headless export).
+    bool    StartTrace( const char* path_ );
+    bool    StopTrace();
+    bool    IsTracing() const { return tracing; }
+    // Without frames nothing drains the ring, which keeps only the last RINGSIZE events: headless
+    // code calls this regularly to take them into the trace. Any thread; a no-op while another
+    // thread drains.
+    void    Flush();
+
+    static std::atomic<bool>    enabled;            // timers record only while set
+
+    static const int RINGSIZE = 1 << 16;            // events in flight, must be a power of two
+    static const int HISTORYFRAMES = 240;
+    static const int TRACECHUNK = 64 * 1024;        // events buffered before they are written to the trace
+
+private:
+    Profiler();
+
+    struct Slot {
+        std::atomic<unsigned long long> sequence;   // index + 1 once the event at index is written
+        ProfileEvent                    event;
+    };
+    struct Frame {
+        float       scopeMs[ PROFILE_COUNT ];
+        int         calls[ PROFILE_COUNT ];
+        float       frameMs;
+        int         allocations;
+        int         vertices;
+        int         indices;
+    };
+
+    void    Drain( Frame& frame_ );
+    void    WriteTrace();
+
+    Slot*                               ring;
+    std::atomic<unsigned long long>     writeIndex;
+    unsigned long long                  readIndex;
+    std::mutex                          drainLock;      // Drain() has a single consumer at a time
+    unsigned long long                  dropped;
+    Frame                               history[ HISTORYFRAMES ];
+    int                                 frameCount;     // frames recorded so far
+    Frame                               current;
+    long long                           frameStart;
+    int                                 allocationsAtStart;
+    bool                                open;
+    bool                                tracing;
+    std::string                         tracePath;
+    FILE*                               traceFile;
+    std::vector<ProfileEvent>           trace;          // not written yet
+    std::vector<bool>                   traceNamed;     // threads whose track is named in the file
+    unsigned long long                  traceEvents;    // written so far
+    unsigned long long                  traceDropped;   // dropped when the trace started
+    long long                           traceStart;     // events before it belong to no trace
+    int                                 mainThread;     // the thread calling NewFrame(), named in traces
+};
+
+// Times the enclosing scope
+struct ProfileTimer {
+    explicit ProfileTimer( ProfileScope scope_ ) : scope( scope_ ), begin( Profiler::enabled.load( std::memory_order_relaxed ) ? Profiler::Now() : 0 ) {}
+    ~ProfileTimer() { if( begin ) Profiler::Shared().Record( scope, begin, Profiler::Now() ); }
+
+    ProfileScope    scope;
+    long long       begin;  // 0 when not recording
+};
+
+#endif
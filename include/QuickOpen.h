@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef _QUICKOPEN_H
+#define _QUICKOPEN_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "WorkspaceIndex.h"
+
+struct ImGuiInputTextCallbackData;
+
+// Fuzzy score of text_ for query_ (case-insensitive subsequence match), higher is better.
+// Matches on word starts, after a '/' and runs of consecutive characters score more, gaps less.
+// Returns FUZZYNOMATCH when query_ is not a subsequence of text_.
+static const int FUZZYNOMATCH = -0x7FFFFFFF;
+int FuzzyScore( const char* query_, int queryLength_, const char* text_, int textLength_ );
+
+// Ctrl+P popup that finds a note of the workspace by a fuzzy match on its path.
+// Every path gets a 64 bit mask of the character classes it contains, so most candidates are
+// rejected with one AND before the matcher runs. Large candidate sets are split across the
+// ThreadPool, each part keeps its own top-K heap and the heaps are merged.
+// The candidates that matched the last query are kept: when the query grows, only they are
+// scored again, since a longer query can only match fewer paths.
+struct QuickOpen {
+    QuickOpen() : entriesVersion( ~0u ), open( false ), focus( false ), selected( 0 ), scrollToSelected( false ) { query[ 0 ] = 0; }
+
+    // Returns the full path of the chosen note, empty otherwise
+    std::string Show( WorkspaceIndex& workspace_ );
+
+    // Candidate paths (not copied: they must stay alive) and their lengths
+    void    SetCandidates( std::vector<const char*> paths_, std::vector<int> lengths_ );
+    // Scores the candidates for query_ and keeps the TOPK best in results
+    void    Search( const char* query_ );
+
+    struct Result {
+        int     score;
+        int     index;          // in the candidate paths
+    };
+    std::vector<Result>         results;            // best first
+
+    static const int TOPK = 100;
+    static const int PARALLELMIN = 32 * 1024;      // fewer candidates are scored on the calling thread
+    static const int GRAIN = 16 * 1024;
+
+private:
+    static int InputCallback( ImGuiInputTextCallbackData* data_ );
+
+    std::shared_ptr<const WorkspaceEntries> entries;
+    unsigned                    entriesVersion;
+    std::vector<const char*>    paths;
+    std::vector<int>            lengths;
+    std::vector<unsigned long long> masks;          // character classes of each path
+    std::vector<int>            survivors;          // candidates matching survivorQuery, in order
+    std::string                 survivorQuery;
+    bool                        haveSurvivors = false;
+    std::string                 lastQuery;          // query results are for
+    char                        query[ 256 ];
+    bool                        open;
+    bool                        focus;
+    int                         selected;
+    bool                        scrollToSelected;   // the selection moved: bring it into view once, then leave the scroll alone
+};
+
+#endif
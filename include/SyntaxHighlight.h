@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef _SYNTAXHIGHLIGHT_H
+#define _SYNTAXHIGHLIGHT_H
+
+#include "imgui.h"
+
+// Small table driven lexer for the fenced code blocks of the preview (and, through
+// HighlightMarkdownLine(), of the code in the editor).
+// Each language is described by its keywords, comment markers and string delimiters; there is
+// no grammar, which is enough to color the common cases and keeps tokenizing a single pass.
+
+enum SyntaxToken {
+    SYNTAX_TEXT,
+    SYNTAX_KEYWORD,
+    SYNTAX_STRING,
+    SYNTAX_NUMBER,
+    SYNTAX_COMMENT,
+    SYNTAX_PREPROCESSOR,
+    // Markdown source in the editor
+    SYNTAX_HEADING,
+    SYNTAX_EMPHASIS,
+    SYNTAX_LINK,
+    SYNTAX_CODE,                        // code spans and fence lines
+};
+
+struct SyntaxRun {
+    int             start;              // offset from the start of the highlighted text
+    int             length;
+    SyntaxToken     token;
+};
+
+struct SyntaxLanguage {
+    const char*         names;          // space separated names accepted after the opening fence
+    const char* const*  keywords;       // NULL terminated
+    const char*         lineComment;
+    const char*         blockCommentOpen;
+    const char*         blockCommentClose;
+    const char*         stringDelimiters;
+    char                preprocessor;   // starts a preprocessor line when first on the line
+};
+
+// Returns NULL for unknown languages, whose code is shown as plain text
+const SyntaxLanguage* FindSyntaxLanguage( const char* name_, const char* nameEnd_ );
+
+// Appends the runs of one line (offsets relative to base_). state_ carries an open block
+// comment from one line to the next and must start at 0.
+void HighlightLine( const SyntaxLanguage* lang_, const char* base_, const char* line_, const char* lineEnd_, int* state_, ImVector<SyntaxRun>& runs_ );
+
+// Appends a run, merged into the last one when it continues it with the same token
+void AddSyntaxRun( ImVector<SyntaxRun>& runs_, int start_, int length_, SyntaxToken token_ );
+
+ImU32 SyntaxColor( SyntaxToken token_ );
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+// Work-stealing thread pool for the background jobs (searching, indexing, exporting).
+// Every worker owns a deque: tasks submitted from a worker go to its own deque and are run
+// newest first, so a task that fans out keeps its data hot; idle workers steal the oldest task
+// of another worker. Tasks submitted from other threads are dealt round robin.
+struct ThreadPool {
+    explicit ThreadPool( int threads_ = 0 );        // 0: one per hardware thread
+    ~ThreadPool();
+
+    void    Submit( std::function<void()> task_ );
+    int     Size() const { return (int)workers.size(); }
+    // Runs body_( begin, end ) over [0, count_) in chunks of grain_ items and returns when all are
+    // done. The calling thread takes chunks too, so this can also be used from inside a task.
+    void    ParallelFor( int count_, int grain_, const std::function<void( int, int )>& body_ );
+
+    // Pool shared by the application, created on first use
+    static ThreadPool& Shared();
+
+private:
+    struct Queue {
+        std::mutex                          mutex;
+        std::deque<std::function<void()>>   tasks;
+    };
+
+    void    WorkerMain( int index_ );
+    bool    Pop( int index_, std::function<void()>& task_ );
+
+    std::vector<std::thread>    workers;
+    std::vector<Queue>          queues;
+    std::mutex                  sleepMutex;
+    std::condition_variable     wake;
+    std::atomic<int>            pending;            // submitted and not yet started
+    std::atomic<unsigned>       next;               // round robin for outside submissions
+    bool                        stop;
+};
+
+#endif
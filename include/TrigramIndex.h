@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef _TRIGRAMINDEX_H
+#define _TRIGRAMINDEX_H
+
+#include <vector>
+#include "MarkdownDocument.h"
+
+// Full-text index over a text buffer, for substring search.
+// The text is cut into chunks of about CHUNKSIZE bytes. Each chunk keeps a bitmap with one bit
+// set for every (ASCII case folded) trigram starting in it, so a query only scans the chunks whose
+// bitmap has all of its trigrams - usually none or a few instead of the whole text.
+// Edits re-index only the chunks they touch, and chunk offsets are not stored, so nothing has to
+// be shifted after an insert.
+// A chunk also indexes the trigrams starting in the first OVERLAP bytes after it, so a match
+// that starts in a chunk can be filtered on that chunk alone.
+struct TrigramIndex {
+    TrigramIndex() : built(false) {}
+
+    void    Build( const char* text_, int length_ );
+    void    Clear();
+    bool    IsBuilt() const { return built; }
+    size_t  Bytes() const { return chunks.capacity() * sizeof( Chunk ) + chunks.size() * BITMAPBITS / 8; }
+    // edit_ has already been applied: text_ / length_ is the new text
+    void    Update( const ImGui::MarkdownEdit& edit_, const char* text_, int length_ );
+    // Offsets of the matches of query_ in text_, in order, at most maxMatches_ of them
+    void    Find( const char* text_, int length_, const char* query_, int queryLength_, bool caseSensitive_,
+                ImVector<int>& matches_, int maxMatches_ ) const;
+
+    static const int CHUNKSIZE = 64 * 1024;
+    static const int OVERLAP = 64;                      // longest query prefix checked against the bitmaps
+    static const int BITMAPBITS = 64 * 1024;            // ~1/8 of the text size, few false positives
+
+private:
+    struct Chunk {
+        int                         length = 0;
+        std::vector<unsigned long long> bits;
+    };
+
+    void    IndexChunk( Chunk& chunk_, const char* text_, int start_, int length_ );
+
+    std::vector<Chunk>  chunks;
+    bool                built;
+};
+
+#endif
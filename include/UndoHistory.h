@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef _UNDOHISTORY_H
+#define _UNDOHISTORY_H
+
+#include <string>
+#include <deque>
+#include "MarkdownDocument.h"
+
+// Undo / redo for the editor, in place of the fixed size store of the text widget.
+// Every change is kept as a delta: its position, the bytes it deleted and the bytes it inserted,
+// so undoing or redoing it costs in proportion to the change whatever the size of the document
+// (a 10 MB paste is undone by deleting 10 MB). Keystrokes that follow each other are merged into
+// one entry; entries more than KEEPRAW steps back are LZ77 compressed when that saves space; and
+// once the log is over budget its oldest entries are dropped.
+struct UndoHistory {
+    UndoHistory() : budget( DEFAULTBUDGET ), current( 0 ), bytes( 0 ), lastTime( 0.0 ) {}
+
+    // Call for every committed change: deleted_ are the edit_.deleteLength bytes it removed and
+    // inserted_ the edit_.insertLength bytes that replaced them. The redo entries are dropped.
+    void    Record( const ImGui::MarkdownEdit& edit_, const char* deleted_, const char* inserted_ );
+    // The change that reverts the last entry (or replays the next one) and the text it inserts,
+    // false when there is none. Call Undone() / Redone() once it is applied to the text.
+    bool    GetUndo( ImGui::MarkdownEdit* edit_, std::string& text_ ) const;
+    bool    GetRedo( ImGui::MarkdownEdit* edit_, std::string& text_ ) const;
+    void    Undone();
+    void    Redone();
+    void    Clear();
+    // Drops the oldest entries (then the redo entries, newest first) until the log holds at most budget_ bytes
+    void    Trim( size_t budget_ );
+    size_t  Bytes() const { return bytes; }
+
+    size_t  budget;                                         // bytes kept before the oldest entries are dropped
+
+    static const size_t     DEFAULTBUDGET = 32 * 1024 * 1024;
+    static const int        KEEPRAW = 16;                   // newest entries never compressed
+    static const int        MINCOMPRESS = 256;              // nor entries smaller than this
+    static const int        MERGEBYTES = 4;                 // changes this small are merged...
+    static constexpr double MERGESECONDS = 1.0;             // ...when they come this close together
+
+private:
+    struct Entry {
+        int         pos;
+        int         deleteLength;
+        int         insertLength;
+        bool        compressed;
+        std::string data;                   // the deleted bytes then the inserted ones
+    };
+
+    bool    Merge( const ImGui::MarkdownEdit& edit_, const char* deleted_, const char* inserted_ );
+    void    Unpack( const Entry& entry_, std::string& text_ ) const;
+    void    Compress( Entry& entry_ );
+
+    std::deque<Entry>   entries;
+    int                 current;            // entries [0, current) can be undone, [current, size) redone
+    size_t              bytes;
+    double              lastTime;           // of the last Record(), for merging
+};
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef _WORKSPACEINDEX_H
+#define _WORKSPACEINDEX_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+struct WorkspaceEntry {
+    std::string                 path;               // relative to the workspace root
+    long long                   size = 0;
+    long long                   mtime = 0;          // nanoseconds
+    std::string                 title;              // text of the first H1, empty if none
+    std::vector<std::string>    links;              // targets of the [text](target) links
+};
+
+typedef std::vector<WorkspaceEntry> WorkspaceEntries;
+
+// Index of the notes (.md files) under a folder.
+// Open() loads the index saved in <root>/.mdindex, so the file tree is complete right away.
+// A background thread then walks the folder, re-reads only the files whose size or mtime
+// changed, and afterwards follows the changes with inotify. Each time the entries change it
+// publishes a new immutable snapshot and, a little later, saves the index again.
+//
+// Index layout: "MDX1", varint entry count, then for every entry, sorted by path:
+//   varint shared path prefix with the previous entry, varint suffix length, suffix,
+//   varint size, varint mtime, varint title length, title, varint link count, links (varint length, bytes)
+struct WorkspaceIndex {
+    WorkspaceIndex();
+    ~WorkspaceIndex() { Close(); }
+
+    bool    Open( const char* root_ );
+    void    Close();
+    bool    IsOpen() const { return worker.joinable(); }
+    const std::string& Root() const { return root; }
+
+    // Latest snapshot, sorted by path. Sharing it costs a reference count, not a copy.
+    std::shared_ptr<const WorkspaceEntries> Entries() const;
+    unsigned Version() const { return version; }
+    bool    IsScanning() const { return scanning; }
+
+    // File tree panel; returns the full path of the note that was clicked, empty otherwise
+    std::string ShowTree();
+
+    static const char*      INDEXNAME;
+    static const int        MAXPARSEBYTES = 4 * 1024 * 1024;  // title and links are read from this much of a file
+    static constexpr double PUBLISHSECONDS = 0.25;            // changes are published at most this often...
+    static constexpr double SAVESECONDS = 2.0;                // ...and saved after this long without more
+
+private:
+    typedef std::map<std::string, WorkspaceEntry> EntryMap;
+    struct TreeNode {
+        std::string         name;
+        int                 entry = -1;             // index in treeEntries, -1 for folders
+        std::vector<int>    folders;                // child nodes
+        std::vector<int>    files;
+    };
+
+    void    WorkerMain();
+    void    Scan( const std::string& dir_, EntryMap& files_, std::set<std::string>* seen_, bool* changed_ );
+    bool    Refresh( const std::string& path_, EntryMap& files_ );
+    void    Publish( const EntryMap& files_ );
+    bool    Save( const EntryMap& files_ );
+    bool    Load( WorkspaceEntries& entries_ );
+    void    AddWatch( const std::string& dir_ );
+
+    void    BuildTree();
+    void    ShowNode( int node_, std::string& clicked_ );
+
+    std::string             root;
+    std::thread             worker;
+    int                     stopPipe[ 2 ];
+    int                     watchFd;                // worker only from here on
+    std::atomic<bool>       stopping;               // set by Close(), checked by the walk
+    std::map<int, std::string> watches;             // inotify watch -> folder
+
+    mutable std::mutex      mutex;
+    std::shared_ptr<const WorkspaceEntries> snapshot;
+    std::atomic<unsigned>   version;
+    std::atomic<bool>       scanning;
+
+    // main thread: tree built from the snapshot of treeVersion
+    std::shared_ptr<const WorkspaceEntries> treeEntries;
+    std::vector<TreeNode>   tree;
+    unsigned                treeVersion;
+};
+
+#endif
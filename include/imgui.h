@@ -2831,7 +2831,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_SignedDistanceField = 1 << 3   // Rasterize glyphs as signed distance fields (stb_truetype builder only): alpha is 0.5 on the outline, falling to 0 at TexSdfSpread texels outside. One bitmap at SizePixels then stays sharp at any ImFont::Scale or FontGlobalScale, but the renderer backend must threshold the font texture (see imgui_impl_opengl3). OversampleH/V and RasterizerMultiply are ignored. Implies NoMouseCursors and NoBakedLines.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2861,6 +2862,7 @@ struct ImFontAtlas
     IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after destruction of the atlas. Set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedBase85TTF(const char* compressed_font_data_base85, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);              // 'compressed_font_data_base85' still owned by caller. Compress with binary_to_compressed_c.cpp with -base85 parameter.
+    IMGUI_API ImFont*           AddFontScaled(ImFont* src_font, float scale);   // Another size of 'src_font' drawing its glyphs (nothing is rasterized for it), so only sharp with ImFontAtlasFlags_SignedDistanceField. Copied from 'src_font' again after every build. Merge no font into it.
     IMGUI_API void              ClearInputData();           // Clear input data (all ImFontConfig structures including sizes, TTF data, glyph ranges, etc.) = all the data used to build the texture and fonts.
     IMGUI_API void              ClearTexData();             // Clear output texture data (CPU side). Saves RAM once the texture has been copied to graphics memory.
     IMGUI_API void              ClearFonts();               // Clear output font data (glyphs storage, UV coordinates).
@@ -2920,6 +2922,8 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    int                         TexSdfSpread;       // Distance range in pixels on each side of glyph outlines with ImFontAtlasFlags_SignedDistanceField. Defaults to 4. Larger values allow wider outlines and smaller scales, at the cost of texture space.
+    void                        (*BuildParallelForFn)(int count, void (*job)(void* user_data, int index), void* user_data); // = NULL // Optional: call job(user_data, 0..count-1) from any threads and return when all calls are done. Used for the distance fields of ImFontAtlasFlags_SignedDistanceField, which are slow to compute. Jobs allocate with IM_ALLOC().
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
 
     // [Internal]
@@ -2952,6 +2956,12 @@ struct ImFontAtlas
 
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
+// Codepoints below IM_FONT_DENSE_CODEPOINTS (Latin and the other alphabetic scripts) are looked up in the dense IndexAdvanceX/IndexLookup.
+// Codepoints above go through a two-level table: PageMap selects a page of IM_FONT_PAGE_SIZE entries, and only the pages holding glyphs are allocated,
+// so merging a few thousand CJK glyphs does not cost a dense table up to U+FFFF in every font.
+#define IM_FONT_DENSE_CODEPOINTS    0x0800
+#define IM_FONT_PAGE_SHIFT          8
+#define IM_FONT_PAGE_SIZE           (1 << IM_FONT_PAGE_SHIFT)
 struct ImFont
 {
     // Members: Hot ~20/24 bytes (for CalcTextSize)
@@ -2976,13 +2986,18 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    ImVector<ImU16>             PageMap;            // 12-16 // out //            // Codepoints above IndexLookup.Size: (page number + 1) of every block of IM_FONT_PAGE_SIZE codepoints in PagedAdvanceX/PagedLookup, 0 for blocks without glyphs.
+    ImVector<float>             PagedAdvanceX;      // 12-16 // out //            // Allocated pages of advances, IM_FONT_PAGE_SIZE each.
+    ImVector<ImWchar>           PagedLookup;        // 12-16 // out //            // Allocated pages of glyph indices, IM_FONT_PAGE_SIZE each.
+    int                         ScaledSourceN;      // 4     // in  // = -1       // AddFontScaled(): index in ContainerAtlas->Fonts of the font this one is a scaled copy of, -1 otherwise.
+    float                       ScaledSourceScale;  // 4     // in  // = 1.f      // AddFontScaled(): its scale relative to that font.
 
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { if ((int)c < IndexAdvanceX.Size) return IndexAdvanceX.Data[(int)c]; const int page = (int)(c >> IM_FONT_PAGE_SHIFT); return (page < PageMap.Size && PageMap.Data[page]) ? PagedAdvanceX.Data[((PageMap.Data[page] - 1) << IM_FONT_PAGE_SHIFT) + (c & (IM_FONT_PAGE_SIZE - 1))] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
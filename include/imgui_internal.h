@@ -1021,13 +1021,18 @@ struct IMGUI_API ImGuiInputTextState
     bool                    SelectedAllMouseLock;   // after a double-click to select all, we ignore further mouse drags to update selection
     bool                    Edited;                 // edited this frame
     ImGuiInputTextFlags     Flags;                  // copy of InputText() flags
+    int                     UnchangedHeadA;         // UTF-8 bytes at the start of the text, and at its end, that no edit touched since ClearChanged()
+    int                     UnchangedTailA;         // (both 0 after the text is loaded or replaced as a whole: treat it all as changed)
+    int                     OffsetW, OffsetA;       // character index and UTF-8 offset of the last edit, so the next one is located from there
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); ResetChanged(); }
     void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
     int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
+    void        ClearChanged()              { UnchangedHeadA = UnchangedTailA = INT_MAX; }
+    void        ResetChanged()              { UnchangedHeadA = UnchangedTailA = OffsetW = OffsetA = 0; }
 
     // Cursor & Selection
     void        CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
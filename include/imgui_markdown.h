@@ -35,17 +35,10 @@ API BREAKING CHANGES
 #include "imgui_impl_opengl3.h"
 #include "imgui.h"
 #include "LoadImage.h"
+#include "Profiler.h"
 //#define STB_IMAGE_IMPLEMENTATION
 //#include "stb_image.h"
 
-struct ListNode {
-    GLuint value;
-    ListNode* next;
-    ListNode() : value(0), next(nullptr) {}
-    ListNode(GLuint val_, ListNode* next_)
-        : value(val_), next(next_) {}
-};
-
 namespace ImGui {
     //-----------------------------------------------------------------------------
     // Basic types
@@ -53,6 +46,7 @@ namespace ImGui {
 
     struct Link;
     struct MarkdownConfig;
+    struct MarkdownDocument;
 
     struct MarkdownLinkCallbackData                                 // for both links and images
     {
@@ -74,8 +68,7 @@ namespace ImGui {
     struct MarkdownImageData {
         bool                    isValid = false;                    // if true, will draw the image
         bool                    useLinkCallback = false;            // if true, linkCallback will be called when image is clicked
-        //ImTextureID             user_texture_id = 0;                // see ImGui::Image
-        GLuint           user_texture_id = 0;                // see ImGui::Image
+        ImTextureID             user_texture_id = 0;                // see ImGui::Image
 
         ImVec2                  size = ImVec2( 100.0f, 100.0f );    // see ImGui::Image
         ImVec2                  uv0 = ImVec2( 0, 0 );               // see ImGui::Image
@@ -126,6 +119,7 @@ namespace ImGui {
     // - linkCallback is called when a link is clicked on
     // - linkIcon is a string which encode a "Link" icon, if available in the current font (e.g. linkIcon = ICON_FA_LINK with FontAwesome + IconFontCppHeaders https://github.com/juliettef/IconFontCppHeaders)
     // - headingFormats controls the format of heading H1 to H3, those above H3 use H3 format
+    // - codeFont is used for fenced code blocks
     struct MarkdownConfig {
         static const int        NUMHEADINGS = 3;
 
@@ -134,16 +128,23 @@ namespace ImGui {
         //MarkdownImageCallback*  imageCallback = NULL;
         ImageCallback*  imageCallback = NULL;
         const char*             linkIcon = "";                      // icon displayd in link tooltip
+        ImFont*                 codeFont = NULL;                    // monospace font for code blocks, current font if NULL
         MarkdownHeadingFormat   headingFormats[ NUMHEADINGS ] = { { NULL, true }, { NULL, true }, { NULL, true } };
         void*                   userData = NULL;
         MarkdownFormalCallback* formatCallback = defaultMarkdownFormatCallback;
+        // search matches to tint: sorted offsets from highlightBase, each highlightLength bytes long
+        const char*             highlightBase = NULL;
+        const int*              highlights = NULL;
+        int                     highlightCount = 0;
+        int                     highlightLength = 0;
+        int                     currentHighlight = -1;              // index in highlights drawn in a stronger color
     };
 
     //-----------------------------------------------------------------------------
     // External interface
     //-----------------------------------------------------------------------------
 
-    inline ListNode* Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ );
+    void Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ );
 
     //-----------------------------------------------------------------------------
     // Internals
@@ -153,9 +154,10 @@ namespace ImGui {
     struct Line;
     inline void UnderLine( ImColor col_ );
     inline void RenderLine( const char* markdown_, Line& line_, TextRegion& textRegion_, const MarkdownConfig& mdConfig_ );
+    inline void HighlightMatches( const char* text_, const char* text_end_, const MarkdownConfig& mdConfig_ );
 
     struct TextRegion {
-        TextRegion() : indentX( 0.0f )
+        TextRegion( const MarkdownConfig* mdConfig_ = NULL ) : indentX( 0.0f ), mdConfig( mdConfig_ )
         {
         }
         ~TextRegion()
@@ -166,10 +168,13 @@ namespace ImGui {
         // ImGui::TextWrapped will wrap at the starting position
         // so to work around this we render using our own wrapping for the first line
         void RenderTextWrapped( const char* text_, const char* text_end_, bool bIndentToHere_ = false ) {
-            float       scale = ImGui::GetIO().FontGlobalScale;
+            float       scale = ImGui::GetFontSize() / ImGui::GetFont()->FontSize;   // font, global and window scale
             float       widthLeft = GetContentRegionAvail().x;
             const char* endLine = ImGui::GetFont()->CalcWordWrapPositionA( scale, text_, text_end_, widthLeft );
             ImGui::TextUnformatted( text_, endLine );
+            if( mdConfig ) {
+                HighlightMatches( text_, endLine, *mdConfig );
+            }
             if( bIndentToHere_ ) {
                 float indentNeeded = GetContentRegionAvail().x - widthLeft;
                 if( indentNeeded ) {
@@ -186,6 +191,9 @@ namespace ImGui {
                     endLine++;
                 }
                 ImGui::TextUnformatted( text_, endLine );
+                if( mdConfig ) {
+                    HighlightMatches( text_, endLine, *mdConfig );
+                }
             }
         }
 
@@ -211,6 +219,7 @@ namespace ImGui {
 
     private:
         float       indentX;
+        const MarkdownConfig* mdConfig;     // for the search highlights, may be NULL
     };
 
     // Text that starts after a new line (or at beginning) and ends with a newline (or at end)
@@ -269,6 +278,7 @@ namespace ImGui {
     }
 
     inline void RenderLine( const char* markdown_, Line& line_, TextRegion& textRegion_, const MarkdownConfig& mdConfig_ ) {
+        ProfileTimer timer( PROFILE_RENDERLINE );
         // indent
         int indentStart = 0;
         if( line_.isUnorderedListStart )    // ImGui unordered list render always adds one indent
@@ -324,7 +334,37 @@ namespace ImGui {
     }
     
     // render markdown
-    inline ListNode* Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ ); 
+    void Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ );
+
+    // Tints the search matches inside text_..text_end_, which was just drawn as the last item on one line
+    inline void HighlightMatches( const char* text_, const char* text_end_, const MarkdownConfig& mdConfig_ ) {
+        if( mdConfig_.highlightCount == 0 || text_ < mdConfig_.highlightBase ) {
+            return;
+        }
+        const int   start = (int)( text_ - mdConfig_.highlightBase );
+        const int   stop = (int)( text_end_ - mdConfig_.highlightBase );
+        // first match ending after start
+        int lo = 0, hi = mdConfig_.highlightCount;
+        while( lo < hi ) {
+            int mid = ( lo + hi ) / 2;
+            if( mdConfig_.highlights[ mid ] + mdConfig_.highlightLength <= start ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        ImVec2 min = ImGui::GetItemRectMin();
+        ImVec2 max = ImGui::GetItemRectMax();
+        for( int i = lo; i < mdConfig_.highlightCount && mdConfig_.highlights[ i ] < stop; ++i ) {
+            int b = mdConfig_.highlights[ i ] > start ? mdConfig_.highlights[ i ] : start;
+            int e = mdConfig_.highlights[ i ] + mdConfig_.highlightLength < stop ? mdConfig_.highlights[ i ] + mdConfig_.highlightLength : stop;
+            float x0 = min.x + ImGui::CalcTextSize( text_, text_ + ( b - start ) ).x;
+            float x1 = x0 + ImGui::CalcTextSize( text_ + ( b - start ), text_ + ( e - start ) ).x;
+            ImU32 col = ImGui::GetColorU32( i == mdConfig_.currentHighlight ? ImGuiCol_PlotHistogram : ImGuiCol_TextSelectedBg, 0.6f );
+            ImGui::GetWindowDrawList()->AddRectFilled( ImVec2( x0, min.y ), ImVec2( x1, max.y ), col );
+        }
+    }
 
     inline bool TextRegion::RenderLinkText( const char* text_, const char* text_end_, const Link& link_,
         const char* markdown_, const MarkdownConfig& mdConfig_, const char** linkHoverStart_ ) {
@@ -335,6 +375,7 @@ namespace ImGui {
         ImGui::PushTextWrapPos( -1.0f );
         ImGui::TextUnformatted( text_, text_end_ );
         ImGui::PopTextWrapPos();
+        HighlightMatches( text_, text_end_, mdConfig_ );
 
         bool bThisItemHovered = ImGui::IsItemHovered();
         if(bThisItemHovered) {
@@ -358,7 +399,7 @@ namespace ImGui {
 
     inline void TextRegion::RenderLinkTextWrapped( const char* text_, const char* text_end_, const Link& link_,
         const char* markdown_, const MarkdownConfig& mdConfig_, const char** linkHoverStart_, bool bIndentToHere_ ) {
-            float       scale = ImGui::GetIO().FontGlobalScale;
+            float       scale = ImGui::GetFontSize() / ImGui::GetFont()->FontSize;   // font, global and window scale
             float       widthLeft = GetContentRegionAvail().x;
             const char* endLine = ImGui::GetFont()->CalcWordWrapPositionA( scale, text_, text_end_, widthLeft );
             bool bHovered = RenderLinkText( text_, endLine, link_, markdown_, mdConfig_, linkHoverStart_ );
@@ -474,10 +515,14 @@ void LinkCallback( ImGui::MarkdownLinkCallbackData data_ );
 
 inline ImGui::MarkdownImageData ImageCallback( ImGui::MarkdownLinkCallbackData data_ );
 
-void LoadFonts( float fontSize_ );
+// With signedDistanceField_ the atlas holds one distance field per glyph and weight, shared by the headings
+// and any zoom; the renderer backend must support ImFontAtlasFlags_SignedDistanceField (imgui_impl_opengl3 does).
+void LoadFonts( float fontSize_, bool signedDistanceField_ = false );
 
 void ExampleMarkdownFormatCallback( const ImGui::MarkdownFormatInfo& markdownFormatInfo_, bool start_ );
 
-ListNode* Markdown( const std::string& markdown_ );
+void Markdown( const std::string& markdown_ );
+
+void Markdown( ImGui::MarkdownDocument& doc_ );
 
 void MarkdownExample();
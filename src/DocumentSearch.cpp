@@ -0,0 +1,104 @@
+#include "DocumentSearch.h"
+#include "imgui.h"
+
+#include <string.h>
+#include <algorithm>
+
+void DocumentSearch::OnEdit( const ImGui::MarkdownEdit& edit_, ImGui::MarkdownDocument& doc_ )
+{
+    if( edit_.IsEmpty() )
+        return;
+    index.Update( edit_, doc_.Text(), doc_.Length() );
+    if( !lastQuery.empty() )
+        Run( doc_ );
+}
+
+void DocumentSearch::OnReload( ImGui::MarkdownDocument& doc_ )
+{
+    index.Clear();
+    if( !lastQuery.empty() )
+        Run( doc_ );
+}
+
+void DocumentSearch::Run( ImGui::MarkdownDocument& doc_ )
+{
+    // keep the current match where it was, as far as possible
+    int previous = doc_.currentMatch >= 0 && doc_.currentMatch < doc_.matches.Size ? doc_.matches[ doc_.currentMatch ] : 0;
+    lastQuery = query;
+    if( lastQuery.empty() )
+    {
+        doc_.matches.resize( 0 );
+        doc_.currentMatch = -1;
+        return;
+    }
+    if( !index.IsBuilt() )
+        index.Build( doc_.Text(), doc_.Length() );
+    index.Find( doc_.Text(), doc_.Length(), lastQuery.data(), (int)lastQuery.size(), caseSensitive, doc_.matches, MAXMATCHES );
+    doc_.matchLength = (int)lastQuery.size();
+    int current = (int)( std::lower_bound( doc_.matches.begin(), doc_.matches.end(), previous ) - doc_.matches.begin() );
+    doc_.currentMatch = doc_.matches.empty() ? -1 : std::min( current, doc_.matches.Size - 1 );
+}
+
+void DocumentSearch::Select( ImGui::MarkdownDocument& doc_, int match_ )
+{
+    if( doc_.matches.empty() )
+        return;
+    doc_.currentMatch = ( match_ + doc_.matches.Size ) % doc_.matches.Size;
+    doc_.revealMatch = true;
+    doc_.scrollToBlock = doc_.FindBlockAt( doc_.matches[ doc_.currentMatch ] );
+}
+
+void DocumentSearch::Show( ImGui::MarkdownDocument& doc_ )
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if( io.KeyCtrl && !io.KeyShift && ImGui::IsKeyPressed( ImGuiKey_F ) )
+    {
+        open = true;
+        focus = true;
+    }
+    if( !open )
+    {
+        if( !lastQuery.empty() )
+        {
+            query[ 0 ] = 0;
+            Run( doc_ );
+        }
+        return;
+    }
+
+    ImGui::Begin( "search", &open );
+    if( focus )
+    {
+        ImGui::SetKeyboardFocusHere();
+        focus = false;
+    }
+    bool enter = ImGui::InputText( "##query", query, IM_ARRAYSIZE( query ), ImGuiInputTextFlags_EnterReturnsTrue );
+    if( enter )
+        ImGui::SetKeyboardFocusHere( -1 );          // stay in the box to step through the matches
+    ImGui::SameLine();
+    bool toggled = ImGui::Checkbox( "Aa", &caseSensitive );
+    if( toggled || lastQuery != query )
+    {
+        Run( doc_ );
+        Select( doc_, doc_.currentMatch );
+    }
+
+    ImGui::SameLine();
+    bool previous = ImGui::ArrowButton( "##previous", ImGuiDir_Up ) || ( enter && io.KeyShift ) || ( ImGui::IsKeyPressed( ImGuiKey_F3 ) && io.KeyShift );
+    ImGui::SameLine();
+    bool next = ImGui::ArrowButton( "##next", ImGuiDir_Down ) || ( enter && !io.KeyShift ) || ( ImGui::IsKeyPressed( ImGuiKey_F3 ) && !io.KeyShift );
+    if( previous )
+        Select( doc_, doc_.currentMatch - 1 );
+    else if( next )
+        Select( doc_, doc_.currentMatch + 1 );
+
+    ImGui::SameLine();
+    if( doc_.matches.empty() )
+    {
+        if( !lastQuery.empty() )
+            ImGui::TextDisabled( "no match" );
+    }
+    else
+        ImGui::Text( "%d / %d%s", doc_.currentMatch + 1, doc_.matches.Size, doc_.matches.Size >= MAXMATCHES ? "+" : "" );
+    ImGui::End();
+}
@@ -0,0 +1,161 @@
+#include "DocumentTabs.h"
+#include "MarkdownEditor.h"
+#include "LoadImage.h"
+#include "imgui.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+static size_t DocumentBytes( const OpenDocument& document_ )
+{
+    return document_.doc.CacheBytes() + document_.search.IndexBytes() + document_.undo.Bytes();
+}
+
+OpenDocument* DocumentTabs::Open( const char* path_ )
+{
+    for( size_t i = 0; i < docs.size(); ++i )
+    {
+        if( docs[ i ]->path == path_ )
+        {
+            // the caller may look at its blocks right away
+            docs[ i ]->doc.Restore();
+            select = (int)i;
+            return docs[ i ].get();
+        }
+    }
+    OpenDocument* document = Add( path_ );
+    // edits are diffed against the last committed text, re-parsed locally and journaled
+    document->doc.trackEdits = true;
+    if( !document->journal.Open( path_, document->doc ) )
+    {
+        fprintf( stderr, "Cannot open %s for autosave\n", path_ );
+        Close( (int)docs.size() - 1 );
+        return NULL;
+    }
+    document->search.OnReload( document->doc );
+    return document;
+}
+
+OpenDocument* DocumentTabs::Add( const char* path_ )
+{
+    docs.push_back( std::unique_ptr<OpenDocument>( new OpenDocument() ) );
+    OpenDocument* document = docs.back().get();
+    if( path_ )
+        document->path = path_;
+    else
+        document->doc.trackEdits = true;        // untitled: edited, but not saved
+    select = (int)docs.size() - 1;
+    if( active < 0 )
+        active = select;
+    return document;
+}
+
+void DocumentTabs::Close( int index_ )
+{
+    OpenDocument* document = docs[ index_ ].get();
+    document->journal.Close( document->doc.Text(), document->doc.Length() );
+    docs.erase( docs.begin() + index_ );
+    if( active > index_ || active >= (int)docs.size() )
+        --active;
+    if( select > index_ )
+        --select;
+    else if( select == index_ )
+        select = -1;
+}
+
+void DocumentTabs::CloseAll()
+{
+    while( !docs.empty() )
+        Close( (int)docs.size() - 1 );
+}
+
+void DocumentTabs::ShowEditor()
+{
+    ImGui::Begin( "editor" );
+    if( ImGui::BeginTabBar( "documents", ImGuiTabBarFlags_Reorderable | ImGuiTabBarFlags_FittingPolicyScroll ) )
+    {
+        int closed = -1;
+        for( size_t i = 0; i < docs.size(); ++i )
+        {
+            OpenDocument& document = *docs[ i ];
+            const char* slash = strrchr( document.path.c_str(), '/' );
+            const char* name = document.path.empty() ? "untitled" : slash ? slash + 1 : document.path.c_str();
+            bool keep = true;
+            ImGui::PushID( &document );
+            bool shown = ImGui::BeginTabItem( name, &keep, (int)i == select ? ImGuiTabItemFlags_SetSelected : 0 );
+            if( !document.path.empty() && ImGui::IsItemHovered() )
+                ImGui::SetTooltip( document.journal.Failed() ? "%s\nAutosave is failing, edits are not on disk yet" : "%s", document.path.c_str() );
+            if( shown )
+            {
+                active = (int)i;
+                document.lastFrame = ImGui::GetFrameCount();
+                document.doc.Restore();
+                ImGui::MarkdownEdit edit = ImGui::MarkdownEditor( "##text", document.doc, &document.undo, &document.paste, ImVec2( -FLT_MIN, -FLT_MIN ), ImGuiInputTextFlags_AllowTabInput );
+                if( !edit.IsEmpty() )
+                {
+                    document.journal.Record( edit, document.doc.Text() );
+                    document.search.OnEdit( edit, document.doc );
+                }
+                ImGui::EndTabItem();
+            }
+            ImGui::PopID();
+            if( !keep )
+                closed = (int)i;
+        }
+        select = -1;
+        ImGui::EndTabBar();
+        if( closed >= 0 )
+            Close( closed );
+    }
+    ImGui::End();
+}
+
+void DocumentTabs::Update()
+{
+    for( const std::unique_ptr<OpenDocument>& document : docs )
+        document->journal.Update( document->doc.Text(), document->doc.Length() );
+    if( OpenDocument* document = Active() )
+        document->lastFrame = ImGui::GetFrameCount();
+    Trim();
+    CollectTextures( TEXTUREIDLEFRAMES );
+}
+
+size_t DocumentTabs::CacheBytes() const
+{
+    size_t bytes = 0;
+    for( const std::unique_ptr<OpenDocument>& document : docs )
+        bytes += DocumentBytes( *document );
+    return bytes;
+}
+
+void DocumentTabs::Trim()
+{
+    size_t total = CacheBytes();
+    if( total <= CACHEBUDGET )
+        return;
+    // least recently active first; the active document and the one about to be shown keep everything
+    std::vector<OpenDocument*> order;
+    for( size_t i = 0; i < docs.size(); ++i )
+    {
+        if( (int)i != active && (int)i != select )
+            order.push_back( docs[ i ].get() );
+    }
+    std::sort( order.begin(), order.end(), []( const OpenDocument* a_, const OpenDocument* b_ ) { return a_->lastFrame < b_->lastFrame; } );
+    // what is derived from the text goes first, it is rebuilt when the tab is shown again
+    for( size_t i = 0; i < order.size() && total > CACHEBUDGET; ++i )
+    {
+        size_t before = DocumentBytes( *order[ i ] );
+        order[ i ]->doc.Unload();
+        order[ i ]->search.DropIndex();
+        total -= before - DocumentBytes( *order[ i ] );
+    }
+    // then the oldest undo steps, only as many as needed
+    for( size_t i = 0; i < order.size() && total > CACHEBUDGET; ++i )
+    {
+        UndoHistory& undo = order[ i ]->undo;
+        size_t before = undo.Bytes();
+        undo.Trim( before > total - CACHEBUDGET ? before - ( total - CACHEBUDGET ) : 0 );
+        total -= before - undo.Bytes();
+    }
+}
@@ -0,0 +1,361 @@
+#include "EditJournal.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char   JournalMagic[ 4 ] = { 'M', 'D', 'J', '1' };
+static const size_t JournalHeaderSize = 4 + 8 + 8;
+
+static double Now()
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static unsigned long long Hash64( const char* data_, size_t length_ )
+{
+    unsigned long long h = 14695981039346656037ULL;
+    for( size_t i = 0; i < length_; ++i )
+        h = ( h ^ (unsigned char)data_[ i ] ) * 1099511628211ULL;
+    return h;
+}
+
+static unsigned int Hash32( const char* data_, size_t length_ )
+{
+    unsigned int h = 2166136261u;
+    for( size_t i = 0; i < length_; ++i )
+        h = ( h ^ (unsigned char)data_[ i ] ) * 16777619u;
+    return h;
+}
+
+static void PutU64( std::string& out_, unsigned long long v_ )
+{
+    for( int i = 0; i < 8; ++i )
+        out_ += (char)( ( v_ >> ( i * 8 ) ) & 0xFF );
+}
+
+static unsigned long long GetU64( const char* p_ )
+{
+    unsigned long long v = 0;
+    for( int i = 0; i < 8; ++i )
+        v |= (unsigned long long)(unsigned char)p_[ i ] << ( i * 8 );
+    return v;
+}
+
+static void PutVarint( std::string& out_, unsigned long long v_ )
+{
+    while( v_ >= 0x80 )
+    {
+        out_ += (char)( ( v_ & 0x7F ) | 0x80 );
+        v_ >>= 7;
+    }
+    out_ += (char)v_;
+}
+
+static bool GetVarint( const char*& p_, const char* end_, unsigned long long* v_ )
+{
+    *v_ = 0;
+    for( int shift = 0; p_ < end_ && shift < 64; shift += 7 )
+    {
+        unsigned char c = (unsigned char)*p_++;
+        *v_ |= (unsigned long long)( c & 0x7F ) << shift;
+        if( !( c & 0x80 ) )
+            return true;
+    }
+    return false;
+}
+
+static void PutRecord( std::string& out_, char op_, int pos_, const char* data_, int length_ )
+{
+    size_t begin = out_.size();
+    out_ += op_;
+    PutVarint( out_, (unsigned long long)pos_ );
+    PutVarint( out_, (unsigned long long)length_ );
+    if( data_ )
+        out_.append( data_, (size_t)length_ );
+    unsigned int h = Hash32( out_.data() + begin, out_.size() - begin );
+    for( int i = 0; i < 4; ++i )
+        out_ += (char)( ( h >> ( i * 8 ) ) & 0xFF );
+}
+
+// Applies the records of journal_ to text_, returns the offset just past the last valid record
+static size_t ReplayJournal( const std::string& journal_, std::string& text_ )
+{
+    const char* begin = journal_.data();
+    const char* end = begin + journal_.size();
+    const char* p = begin + JournalHeaderSize;
+    for( ;; )
+    {
+        const char* record = p;
+        unsigned long long pos, length;
+        if( p >= end || ( *p != '+' && *p != '-' ) )
+            break;
+        char op = *p++;
+        if( !GetVarint( p, end, &pos ) || !GetVarint( p, end, &length ) )
+            break;
+        size_t payload = op == '+' ? (size_t)length : 0;
+        if( (size_t)( end - p ) < payload + 4 )
+            break;                      // torn write at the end of the file
+        p += payload;
+        unsigned int h = 0;
+        for( int i = 0; i < 4; ++i )
+            h |= (unsigned int)(unsigned char)p[ i ] << ( i * 8 );
+        if( h != Hash32( record, (size_t)( p - record ) ) )
+            break;
+        if( op == '+' && pos <= text_.size() )
+            text_.insert( (size_t)pos, p - payload, payload );
+        else if( op == '-' && pos + length <= text_.size() )
+            text_.erase( (size_t)pos, (size_t)length );
+        else
+            break;
+        p += 4;
+    }
+    return (size_t)( p - begin );
+}
+
+static bool ReadFile( const std::string& path_, std::string& out_ )
+{
+    out_.clear();
+    int fd = open( path_.c_str(), O_RDONLY );
+    if( fd < 0 )
+        return false;
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+        out_.resize( (size_t)st.st_size );
+        size_t got = 0;
+        ssize_t n;
+        while( got < out_.size() && ( n = read( fd, &out_[ got ], out_.size() - got ) ) > 0 )
+            got += (size_t)n;
+        out_.resize( got );
+    }
+    close( fd );
+    return true;
+}
+
+static bool WriteAll( int fd_, const char* data_, size_t length_ )
+{
+    while( length_ > 0 )
+    {
+        ssize_t n = write( fd_, data_, length_ );
+        if( n <= 0 )
+            return false;
+        data_ += n;
+        length_ -= (size_t)n;
+    }
+    return true;
+}
+
+// A rename is only durable once the directory entry itself is synced
+static void SyncParentDir( const std::string& path_ )
+{
+    size_t slash = path_.find_last_of( '/' );
+    std::string dir = slash == std::string::npos ? std::string( "." ) : path_.substr( 0, slash + 1 );
+    int fd = open( dir.c_str(), O_RDONLY );
+    if( fd >= 0 )
+    {
+        fsync( fd );
+        close( fd );
+    }
+}
+
+// Writes data_ to a temporary file next to path_, syncs it and renames it over path_
+static bool WriteFileAtomic( const std::string& path_, const char* data_, size_t length_ )
+{
+    std::string tmp = path_ + ".tmp";
+    int fd = open( tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( fd < 0 )
+        return false;
+    bool ok = WriteAll( fd, data_, length_ ) && fsync( fd ) == 0;
+    close( fd );
+    if( !ok || rename( tmp.c_str(), path_.c_str() ) != 0 )
+    {
+        unlink( tmp.c_str() );
+        return false;
+    }
+    SyncParentDir( path_ );
+    return true;
+}
+
+bool EditJournal::Open( const char* path_, ImGui::MarkdownDocument& doc_ )
+{
+    Close( NULL, 0 );
+    path = path_;
+    journalPath = path + ".journal";
+
+    std::string base, journal;
+    ReadFile( path, base );
+    bool replay = ReadFile( journalPath, journal )
+        && journal.size() >= JournalHeaderSize
+        && memcmp( journal.data(), JournalMagic, 4 ) == 0
+        && GetU64( journal.data() + 4 ) == base.size()
+        && GetU64( journal.data() + 12 ) == Hash64( base.data(), base.size() );
+
+    if( replay )
+    {
+        // recover the edits made after the last snapshot and keep appending to the same journal
+        std::string text = base;
+        size_t validEnd = ReplayJournal( journal, text );
+        journalFd = open( journalPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC );
+        if( journalFd < 0 || ftruncate( journalFd, (off_t)validEnd ) != 0 )
+            return false;
+        doc_.SetText( text.data(), text.size() );
+        pendingBytes = (long long)( validEnd - JournalHeaderSize );
+    }
+    else
+    {
+        if( !ResetJournal( base.data(), base.size() ) )
+            return false;
+        doc_.SetText( base.data(), base.size() );
+        pendingBytes = 0;
+    }
+
+    lastEditTime = lastSnapshotTime = Now();
+    stop = false;
+    resetFailed = false;
+    failed = false;
+    opened = true;
+    worker = std::thread( &EditJournal::WorkerMain, this );
+    return true;
+}
+
+void EditJournal::Close( const char* text_, int length_ )
+{
+    if( !opened )
+        return;
+    if( text_ && ( pendingBytes > 0 || resetFailed ) )
+        Snapshot( text_, length_ );
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stop = true;
+    }
+    cond.notify_one();
+    worker.join();
+    if( journalFd >= 0 )
+        close( journalFd );
+    journalFd = -1;
+    opened = false;
+}
+
+void EditJournal::Record( const ImGui::MarkdownEdit& edit_, const char* text_ )
+{
+    if( !opened || edit_.IsEmpty() )
+        return;
+    std::string records;
+    if( edit_.deleteLength )
+        PutRecord( records, '-', edit_.pos, NULL, edit_.deleteLength );
+    if( edit_.insertLength )
+        PutRecord( records, '+', edit_.pos, text_ + edit_.pos, edit_.insertLength );
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( jobs.empty() || jobs.back().isSnapshot )
+            jobs.push_back( Job() );
+        jobs.back().records += records;
+    }
+    cond.notify_one();
+    pendingBytes += (long long)records.size();
+    lastEditTime = Now();
+}
+
+void EditJournal::Update( const char* text_, int length_ )
+{
+    if( !opened )
+        return;
+    double now = Now();
+    if( resetFailed != failed )
+    {
+        failed = resetFailed;
+        if( failed )
+            fprintf( stderr, "Cannot restart the journal of %s, autosaving full snapshots\n", path.c_str() );
+    }
+    // the edits since the snapshot are only in memory: write them all again rather than to a stale journal
+    if( failed && now - lastSnapshotTime >= RETRYSECONDS )
+    {
+        Snapshot( text_, length_ );
+        return;
+    }
+    if( pendingBytes == 0 )
+        return;
+    if( pendingBytes >= COMPACTBYTES || ( now - lastEditTime >= IDLESECONDS && now - lastSnapshotTime >= SNAPSHOTSECONDS ) )
+        Snapshot( text_, length_ );
+}
+
+void EditJournal::Snapshot( const char* text_, int length_ )
+{
+    Job job;
+    job.isSnapshot = true;
+    job.snapshot.assign( text_, (size_t)length_ );
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        jobs.push_back( std::move( job ) );
+    }
+    cond.notify_one();
+    pendingBytes = 0;
+    lastSnapshotTime = Now();
+}
+
+bool EditJournal::WriteSnapshot( const std::string& text_ )
+{
+    return WriteFileAtomic( path, text_.data(), text_.size() );
+}
+
+bool EditJournal::ResetJournal( const char* base_, size_t length_ )
+{
+    std::string header( JournalMagic, 4 );
+    PutU64( header, length_ );
+    PutU64( header, Hash64( base_, length_ ) );
+    if( !WriteFileAtomic( journalPath, header.data(), header.size() ) )
+        return false;
+    if( journalFd >= 0 )
+        close( journalFd );
+    journalFd = open( journalPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC );
+    return journalFd >= 0;
+}
+
+void EditJournal::WorkerMain()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    for( ;; )
+    {
+        cond.wait( lock, [this] { return stop || !jobs.empty(); } );
+        if( !stop )                     // let more keystrokes arrive so they share one fsync
+            cond.wait_for( lock, std::chrono::duration<double>( BATCHSECONDS ), [this] { return stop; } );
+        std::vector<Job> batch;
+        batch.swap( jobs );
+        bool stopping = stop;
+        lock.unlock();
+
+        bool unsynced = false;
+        for( size_t i = 0; i < batch.size(); ++i )
+        {
+            Job& job = batch[ i ];
+            if( job.isSnapshot )
+            {
+                // the journal stays valid until the new snapshot and the empty journal are both in place;
+                // once the snapshot is, the old journal no longer matches it and must not be appended to
+                if( WriteSnapshot( job.snapshot ) )
+                {
+                    bool reset = ResetJournal( job.snapshot.data(), job.snapshot.size() ) || ResetJournal( job.snapshot.data(), job.snapshot.size() );
+                    if( !reset && journalFd >= 0 )
+                    {
+                        close( journalFd );
+                        journalFd = -1;
+                    }
+                    resetFailed = !reset;
+                }
+                unsynced = false;
+            }
+            else if( journalFd >= 0 && WriteAll( journalFd, job.records.data(), job.records.size() ) )
+                unsynced = true;
+        }
+        if( unsynced )
+            fdatasync( journalFd );
+
+        lock.lock();
+        if( stopping && jobs.empty() )
+            break;
+    }
+}
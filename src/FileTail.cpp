@@ -0,0 +1,111 @@
+#include "FileTail.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+bool FileTail::Open( const char* path_ )
+{
+    Close();
+    fd = open( path_, O_RDONLY );
+    if( fd < 0 )
+        return false;
+    path = path_;
+    offset = 0;
+#ifdef __linux__
+    watchFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if( watchFd >= 0 && inotify_add_watch( watchFd, path_, IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB ) < 0 )
+    {
+        close( watchFd );
+        watchFd = -1;
+    }
+#endif
+    return true;
+}
+
+void FileTail::Close()
+{
+    if( watchFd >= 0 )
+        close( watchFd );
+    if( fd >= 0 )
+        close( fd );
+    watchFd = -1;
+    fd = -1;
+}
+
+bool FileTail::ReadNew( ImVector<char>& out_ )
+{
+    struct stat st;
+    if( fstat( fd, &st ) != 0 || st.st_size <= offset )
+        return false;
+
+    int start = out_.Size;
+    out_.resize( start + (int)( st.st_size - offset ) );
+    ssize_t got = 0;
+    while( start + got < out_.Size )
+    {
+        ssize_t n = pread( fd, out_.Data + start + got, out_.Size - start - got, offset + got );
+        if( n <= 0 )
+            break;
+        got += n;
+    }
+    out_.resize( start + (int)got );
+    offset += got;
+    return got > 0;
+}
+
+FileTail::PollResult FileTail::Poll( ImVector<char>& out_ )
+{
+    if( fd < 0 )
+        return NONE;
+
+    bool changed = offset == 0;         // the first poll hands out the existing content
+    bool replaced = false;
+#ifdef __linux__
+    if( watchFd >= 0 )
+    {
+        alignas( struct inotify_event ) char events[ 4096 ];
+        ssize_t n;
+        while( ( n = read( watchFd, events, sizeof( events ) ) ) > 0 )
+        {
+            for( char* p = events; p < events + n; )
+            {
+                const struct inotify_event* ev = (const struct inotify_event*)p;
+                if( ev->mask & ( IN_MODIFY | IN_ATTRIB ) )
+                    changed = true;
+                if( ev->mask & ( IN_MOVE_SELF | IN_DELETE_SELF ) )
+                    replaced = true;
+                p += sizeof( struct inotify_event ) + ev->len;
+            }
+        }
+    }
+    else
+        changed = true;
+#else
+    changed = true;
+#endif
+
+    if( replaced )
+    {
+        // log rotation: follow the new file at the same path if there is one
+        std::string reopenPath = path;
+        if( !Open( reopenPath.c_str() ) )
+            return NONE;
+        ReadNew( out_ );
+        return RELOADED;
+    }
+    if( !changed )
+        return NONE;
+
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && st.st_size < offset )
+    {
+        offset = 0;
+        ReadNew( out_ );
+        return RELOADED;
+    }
+    return ReadNew( out_ ) ? APPENDED : NONE;
+}
@@ -0,0 +1,387 @@
+#include "FolderSearch.h"
+#include "ThreadPool.h"
+#include "imgui.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FOLDERSEARCH_SSE2
+#endif
+
+namespace
+{
+    // One file's results, handed from a worker to the UI thread
+    struct Batch {
+        std::atomic<Batch*>             next{ nullptr };
+        int                             generation = 0;
+        std::string                     path;
+        std::vector<FolderSearch::Hit>  hits;
+        std::string                     snippets;
+    };
+
+    struct Query {
+        std::string         root;
+        std::string         needle;
+        bool                caseSensitive = false;
+        int                 generation = 0;
+        std::atomic<int>    active{ 0 };            // tasks queued or running
+    };
+
+    inline unsigned char Fold( unsigned char c_ )
+    {
+        return c_ >= 'A' && c_ <= 'Z' ? (unsigned char)( c_ + ( 'a' - 'A' ) ) : c_;
+    }
+
+    inline bool Equal( const char* a_, const char* b_, int length_, bool caseSensitive_ )
+    {
+        if( caseSensitive_ )
+            return memcmp( a_, b_, (size_t)length_ ) == 0;
+        for( int i = 0; i < length_; ++i )
+        {
+            if( Fold( (unsigned char)a_[ i ] ) != Fold( (unsigned char)b_[ i ] ) )
+                return false;
+        }
+        return true;
+    }
+
+    // First match of needle_ starting in [p_, stop_). Bytes up to stop_ + length_ - 1 are readable.
+    // The SSE2 loop compares the first and the last byte of the needle at 16 positions at once
+    // and only verifies the positions where both agree.
+    const char* FindNext( const char* p_, const char* stop_, const char* needle_, int length_, bool caseSensitive_ )
+    {
+        const unsigned char first = (unsigned char)needle_[ 0 ];
+        const unsigned char last = (unsigned char)needle_[ length_ - 1 ];
+#ifdef FOLDERSEARCH_SSE2
+        const unsigned char firstUpper = caseSensitive_ || Fold( first ) != first ? first : (unsigned char)( first >= 'a' && first <= 'z' ? first - ( 'a' - 'A' ) : first );
+        const unsigned char lastUpper = caseSensitive_ || Fold( last ) != last ? last : (unsigned char)( last >= 'a' && last <= 'z' ? last - ( 'a' - 'A' ) : last );
+        const __m128i firstLo = _mm_set1_epi8( (char)( caseSensitive_ ? first : Fold( first ) ) );
+        const __m128i firstHi = _mm_set1_epi8( (char)firstUpper );
+        const __m128i lastLo = _mm_set1_epi8( (char)( caseSensitive_ ? last : Fold( last ) ) );
+        const __m128i lastHi = _mm_set1_epi8( (char)lastUpper );
+        for( ; stop_ - p_ >= 16; p_ += 16 )
+        {
+            __m128i blockFirst = _mm_loadu_si128( (const __m128i*)p_ );
+            __m128i blockLast = _mm_loadu_si128( (const __m128i*)( p_ + length_ - 1 ) );
+            __m128i eqFirst = _mm_or_si128( _mm_cmpeq_epi8( blockFirst, firstLo ), _mm_cmpeq_epi8( blockFirst, firstHi ) );
+            __m128i eqLast = _mm_or_si128( _mm_cmpeq_epi8( blockLast, lastLo ), _mm_cmpeq_epi8( blockLast, lastHi ) );
+            unsigned mask = (unsigned)_mm_movemask_epi8( _mm_and_si128( eqFirst, eqLast ) );
+            while( mask )
+            {
+                int bit = __builtin_ctz( mask );
+                if( Equal( p_ + bit, needle_, length_, caseSensitive_ ) )
+                    return p_ + bit;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for( ; p_ < stop_; ++p_ )
+        {
+            unsigned char c = (unsigned char)*p_;
+            if( ( c == first || ( !caseSensitive_ && Fold( c ) == Fold( first ) ) ) && Equal( p_, needle_, length_, caseSensitive_ ) )
+                return p_;
+        }
+        return nullptr;
+    }
+
+    const int SLICEBYTES = 4 * 1024 * 1024;        // cancellation is checked between slices
+}
+
+struct FolderSearch::Shared {
+    std::atomic<int>            generation{ 0 };
+    std::atomic<int>            hitCount{ 0 };
+    std::shared_ptr<Query>      current;            // main thread only
+
+    // Intrusive multi-producer single-consumer queue (D. Vyukov): producers only exchange
+    // head, the UI thread alone walks from tail. stub keeps the list non-empty.
+    Batch                       stub;
+    std::atomic<Batch*>         head{ &stub };
+    Batch*                      tail = &stub;
+
+    void Push( Batch* batch_ )
+    {
+        batch_->next.store( nullptr, std::memory_order_relaxed );
+        Batch* prev = head.exchange( batch_, std::memory_order_acq_rel );
+        prev->next.store( batch_, std::memory_order_release );
+    }
+
+    Batch* Pop()
+    {
+        Batch* first = tail;
+        Batch* next = first->next.load( std::memory_order_acquire );
+        if( first == &stub )
+        {
+            if( !next )
+                return nullptr;
+            tail = next;
+            first = next;
+            next = next->next.load( std::memory_order_acquire );
+        }
+        if( next )
+        {
+            tail = next;
+            return first;
+        }
+        if( first != head.load( std::memory_order_acquire ) )
+            return nullptr;                         // a producer is between its two steps
+        Push( &stub );
+        next = first->next.load( std::memory_order_acquire );
+        if( next )
+        {
+            tail = next;
+            return first;
+        }
+        return nullptr;
+    }
+
+    ~Shared()
+    {
+        while( Batch* batch = Pop() )
+            delete batch;
+    }
+};
+
+static void SearchFile( const std::shared_ptr<FolderSearch::Shared>& shared_, const std::shared_ptr<Query>& query_, const std::string& path_ )
+{
+    int fd = open( path_.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 )
+        return;
+    struct stat st;
+    const int length = (int)query_->needle.size();
+    if( fstat( fd, &st ) != 0 || st.st_size < length || st.st_size > 0x7FFFFFFF )
+    {
+        close( fd );
+        return;
+    }
+    void* map = mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if( map == MAP_FAILED )
+        return;
+    madvise( map, (size_t)st.st_size, MADV_SEQUENTIAL );
+
+    const char* data = (const char*)map;
+    const char* end = data + st.st_size;
+    const char* needle = query_->needle.data();
+    Batch* batch = nullptr;
+    int line = 1;
+    const char* counted = data;                     // newlines before this point are in line
+    const char* last = end - length + 1;            // one past the last possible match start
+    for( const char* p = data; p < last; )
+    {
+        if( shared_->generation.load( std::memory_order_relaxed ) != query_->generation )
+            break;
+        const char* stop = last - p > SLICEBYTES ? p + SLICEBYTES : last;
+        const char* match = FindNext( p, stop, needle, length, query_->caseSensitive );
+        if( !match )
+        {
+            p = stop;
+            continue;
+        }
+        for( const char* nl; ( nl = (const char*)memchr( counted, '\n', match - counted ) ) != nullptr; counted = nl + 1 )
+            ++line;
+        counted = match;
+        if( shared_->hitCount.fetch_add( 1, std::memory_order_relaxed ) >= FolderSearch::MAXHITS )
+            break;
+
+        const char* lineStart = match;
+        while( lineStart > data && lineStart[ -1 ] != '\n' && match - lineStart < FolderSearch::MAXSNIPPET / 2 )
+            --lineStart;
+        const char* lineEnd = (const char*)memchr( match, '\n', end - match );
+        if( !lineEnd || lineEnd - lineStart > FolderSearch::MAXSNIPPET )
+            lineEnd = end - lineStart > FolderSearch::MAXSNIPPET ? lineStart + FolderSearch::MAXSNIPPET : end;
+        if( !batch )
+        {
+            batch = new Batch();
+            batch->generation = query_->generation;
+            batch->path = path_;
+        }
+        FolderSearch::Hit hit;
+        hit.file = 0;
+        hit.line = line;
+        hit.offset = (int)( match - data );
+        hit.snippetStart = (int)batch->snippets.size();
+        hit.snippetLength = (int)( lineEnd - lineStart );
+        batch->snippets.append( lineStart, lineEnd );
+        batch->hits.push_back( hit );
+        p = match + length;
+    }
+    munmap( map, (size_t)st.st_size );
+    if( batch )
+        shared_->Push( batch );
+}
+
+static bool IsMarkdownFile( const char* name_ )
+{
+    size_t length = strlen( name_ );
+    return ( length > 3 && strcmp( name_ + length - 3, ".md" ) == 0 )
+        || ( length > 9 && strcmp( name_ + length - 9, ".markdown" ) == 0 );
+}
+
+// Lists one directory: every note and every sub directory becomes a task of its own
+static void WalkFolder( const std::shared_ptr<FolderSearch::Shared>& shared_, const std::shared_ptr<Query>& query_, const std::string& dir_ )
+{
+    DIR* dir = opendir( dir_.c_str() );
+    if( !dir )
+        return;
+    while( dirent* entry = readdir( dir ) )
+    {
+        if( shared_->generation.load( std::memory_order_relaxed ) != query_->generation )
+            break;
+        if( entry->d_name[ 0 ] == '.' )
+            continue;                               // ., .. and hidden folders such as .git
+        std::string path = dir_ + "/" + entry->d_name;
+        bool isDir = entry->d_type == DT_DIR;
+        bool isFile = entry->d_type == DT_REG;
+        if( entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK )
+        {
+            struct stat st;
+            if( stat( path.c_str(), &st ) != 0 )
+                continue;
+            isDir = S_ISDIR( st.st_mode ) && entry->d_type != DT_LNK;
+            isFile = S_ISREG( st.st_mode );
+        }
+        if( isFile && !IsMarkdownFile( entry->d_name ) )
+            continue;
+        if( !isDir && !isFile )
+            continue;
+        ++query_->active;
+        ThreadPool::Shared().Submit( [ shared_, query_, path, isDir ]()
+        {
+            if( isDir )
+                WalkFolder( shared_, query_, path );
+            else if( shared_->generation.load( std::memory_order_relaxed ) == query_->generation )
+                SearchFile( shared_, query_, path );
+            --query_->active;
+        } );
+    }
+    closedir( dir );
+}
+
+FolderSearch::FolderSearch() : shared( std::make_shared<Shared>() ), caseSensitive( false )
+{
+    strcpy( folder, "." );
+    query[ 0 ] = 0;
+}
+
+FolderSearch::~FolderSearch()
+{
+    Cancel();
+}
+
+void FolderSearch::SetFolder( const char* folder_ )
+{
+    snprintf( folder, sizeof( folder ), "%s", folder_ );
+}
+
+void FolderSearch::Start( const char* folder_, const char* query_, bool caseSensitive_ )
+{
+    Cancel();
+    files.clear();
+    hits.clear();
+    snippets.clear();
+    if( !query_[ 0 ] )
+        return;
+
+    std::shared_ptr<Query> query = std::make_shared<Query>();
+    query->root = folder_;
+    while( query->root.size() > 1 && query->root.back() == '/' )
+        query->root.pop_back();
+    query->needle = query_;
+    query->caseSensitive = caseSensitive_;
+    query->generation = shared->generation.load();
+    shared->hitCount = 0;
+    shared->current = query;
+
+    std::shared_ptr<Shared> state = shared;
+    ++query->active;
+    ThreadPool::Shared().Submit( [ state, query ]()
+    {
+        WalkFolder( state, query, query->root );
+        --query->active;
+    } );
+}
+
+void FolderSearch::Cancel()
+{
+    // running tasks compare their generation with this one and stop
+    ++shared->generation;
+    shared->current.reset();
+}
+
+bool FolderSearch::IsRunning() const
+{
+    return shared->current && shared->current->active > 0;
+}
+
+void FolderSearch::Drain()
+{
+    while( Batch* batch = shared->Pop() )
+    {
+        if( shared->current && batch->generation == shared->current->generation && hits.size() < (size_t)MAXHITS )
+        {
+            const int file = (int)files.size();
+            const int base = (int)snippets.size();
+            files.push_back( batch->path );
+            for( Hit hit : batch->hits )
+            {
+                hit.file = file;
+                hit.snippetStart += base;
+                hits.push_back( hit );
+            }
+            snippets += batch->snippets;
+        }
+        delete batch;
+    }
+}
+
+const FolderSearch::Hit* FolderSearch::Show()
+{
+    Drain();
+    const Hit* clicked = nullptr;
+    ImGuiIO& io = ImGui::GetIO();
+    bool focus = io.KeyCtrl && io.KeyShift && ImGui::IsKeyPressed( ImGuiKey_F );
+    if( focus )
+        ImGui::SetNextWindowFocus();
+    ImGui::Begin( "notes search" );
+    // a half typed folder would be walked as a search root (clearing it down to "/" walks the whole disk):
+    // the folder only applies on Enter or when the field loses focus, the query on every keystroke
+    bool changed = ImGui::InputText( "folder", folder, IM_ARRAYSIZE( folder ), ImGuiInputTextFlags_EnterReturnsTrue );
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    if( focus )
+        ImGui::SetKeyboardFocusHere();
+    changed |= ImGui::InputText( "##query", query, IM_ARRAYSIZE( query ) );
+    ImGui::SameLine();
+    changed |= ImGui::Checkbox( "Aa", &caseSensitive );
+    if( changed )
+        Start( folder, query, caseSensitive );
+
+    ImGui::Text( "%d hits in %d files%s", (int)hits.size(), (int)files.size(), IsRunning() ? " ..." : "" );
+    ImGui::BeginChild( "hits" );
+    const size_t rootLength = shared->current ? shared->current->root.size() + 1 : 0;
+    ImGuiListClipper clipper;
+    clipper.Begin( (int)hits.size() );
+    while( clipper.Step() )
+    {
+        for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i )
+        {
+            const Hit& hit = hits[ i ];
+            const std::string& path = files[ hit.file ];
+            ImGui::PushID( i );
+            if( ImGui::Selectable( "##hit" ) )
+                clicked = &hit;
+            ImGui::SameLine( 0.0f, 0.0f );
+            ImGui::TextDisabled( "%s:%d", path.size() > rootLength ? path.c_str() + rootLength : path.c_str(), hit.line );
+            ImGui::SameLine();
+            ImGui::TextUnformatted( snippets.data() + hit.snippetStart, snippets.data() + hit.snippetStart + hit.snippetLength );
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+    return clicked;
+}
@@ -0,0 +1,498 @@
+#include "HtmlExport.h"
+#include "ThreadPool.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <vector>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+static const char* TokenClass( SyntaxToken token_ )
+{
+    switch( token_ )
+    {
+    case SYNTAX_KEYWORD:        return "kw";
+    case SYNTAX_STRING:         return "str";
+    case SYNTAX_NUMBER:         return "num";
+    case SYNTAX_COMMENT:        return "com";
+    case SYNTAX_PREPROCESSOR:   return "pp";
+    default:                    return NULL;
+    }
+}
+
+static void AppendEscaped( std::string& out_, const char* p_, const char* end_ )
+{
+    const char* run = p_;
+    for( ; p_ < end_; ++p_ )
+    {
+        const char* entity = NULL;
+        switch( *p_ )
+        {
+        case '&': entity = "&amp;"; break;
+        case '<': entity = "&lt;"; break;
+        case '>': entity = "&gt;"; break;
+        case '"': entity = "&quot;"; break;
+        case '\r': entity = ""; break;
+        default: continue;
+        }
+        out_.append( run, p_ - run );
+        out_ += entity;
+        run = p_ + 1;
+    }
+    out_.append( run, p_ - run );
+}
+
+// "[text](url)" at p_ (on the '['), with nested parentheses in the url as the renderer allows.
+// Returns the end of the link, NULL if there is none.
+static const char* ParseLink( const char* p_, const char* end_, const char** textEnd_, const char** url_, const char** urlEnd_ )
+{
+    const char* close = (const char*)memchr( p_ + 1, ']', end_ - p_ - 1 );
+    if( !close || close + 1 >= end_ || close[ 1 ] != '(' )
+        return NULL;
+    int depth = 1;
+    for( const char* q = close + 2; q < end_; ++q )
+    {
+        if( *q == '(' )
+            ++depth;
+        else if( *q == ')' && --depth == 0 )
+        {
+            *textEnd_ = close;
+            *url_ = close + 2;
+            *urlEnd_ = q;
+            return q + 1;
+        }
+    }
+    return NULL;
+}
+
+// Link and image targets that may be written out: http, https, mailto and relative urls. Anything
+// else (javascript:, data:, vbscript: ...) would run or load in the pages published from the export.
+// The scheme is read as a browser reads it: leading spaces and control characters are skipped, and
+// tabs and newlines inside it are ignored.
+static bool IsSafeUrl( const char* p_, const char* end_ )
+{
+    while( p_ < end_ && (unsigned char)*p_ <= ' ' )
+        ++p_;
+    char scheme[ 8 ];
+    size_t length = 0;
+    for( ; p_ < end_ && *p_ != ':'; ++p_ )
+    {
+        const char c = *p_;
+        if( c == '\t' || c == '\n' || c == '\r' )
+            continue;
+        const char lower = ( c >= 'A' && c <= 'Z' ) ? (char)( c + ( 'a' - 'A' ) ) : c;
+        const bool schemeChar = ( lower >= 'a' && lower <= 'z' ) || ( length > 0 && ( ( c >= '0' && c <= '9' ) || c == '+' || c == '-' || c == '.' ) );
+        if( !schemeChar )
+            return true;                // '/', '?', '#' or anything else before a ':' : a relative url
+        if( length < sizeof( scheme ) )
+            scheme[ length ] = lower;
+        ++length;
+    }
+    if( p_ == end_ )
+        return true;                    // no scheme
+    static const char* const Allowed[] = { "http", "https", "mailto" };
+    for( const char* allowed : Allowed )
+    {
+        if( strlen( allowed ) == length && memcmp( scheme, allowed, length ) == 0 )
+            return true;
+    }
+    return false;
+}
+
+// Text of one line: links, images and *emphasis* / **strong** opened after a space or at the start.
+// A link or image with an unsafe target is written as its text alone.
+static void AppendInline( std::string& out_, const char* p_, const char* end_ )
+{
+    const char* lineStart = p_;
+    const char* run = p_;
+    while( p_ < end_ )
+    {
+        const char* textEnd;
+        const char* url;
+        const char* urlEnd;
+        const char* next = NULL;
+        bool image = *p_ == '!' && p_ + 1 < end_ && p_[ 1 ] == '[';
+        if( *p_ == '[' || image )
+            next = ParseLink( image ? p_ + 1 : p_, end_, &textEnd, &url, &urlEnd );
+        if( next )
+        {
+            AppendEscaped( out_, run, p_ );
+            const char* text = image ? p_ + 2 : p_ + 1;
+            if( !IsSafeUrl( url, urlEnd ) )
+            {
+                AppendEscaped( out_, text, textEnd );
+                p_ = run = next;
+                continue;
+            }
+            out_ += image ? "<img src=\"" : "<a href=\"";
+            AppendEscaped( out_, url, urlEnd );
+            out_ += image ? "\" alt=\"" : "\">";
+            AppendEscaped( out_, text, textEnd );
+            out_ += image ? "\">" : "</a>";
+            p_ = run = next;
+            continue;
+        }
+
+        if( ( *p_ == '*' || *p_ == '_' ) && ( p_ == lineStart || p_[ -1 ] == ' ' || p_[ -1 ] == '\t' ) )
+        {
+            const char sym = *p_;
+            int count = 1;
+            while( p_ + count < end_ && p_[ count ] == sym )
+                ++count;
+            const char* text = p_ + count;
+            if( count < 3 && text < end_ && *text != ' ' && *text != '\t' )
+            {
+                // closed by the same number of symbols
+                const char* close = text;
+                while( close < end_ && ( close = (const char*)memchr( close, sym, end_ - close ) ) != NULL )
+                {
+                    if( close + count <= end_ && ( count == 1 || close[ 1 ] == sym ) )
+                        break;
+                    ++close;
+                }
+                if( close && close < end_ && close > text )
+                {
+                    AppendEscaped( out_, run, p_ );
+                    out_ += count == 2 ? "<strong>" : "<em>";
+                    AppendEscaped( out_, text, close );
+                    out_ += count == 2 ? "</strong>" : "</em>";
+                    p_ = run = close + count;
+                    continue;
+                }
+            }
+        }
+        ++p_;
+    }
+    AppendEscaped( out_, run, end_ );
+}
+
+static bool IsRule( const char* p_, const char* end_ )
+{
+    while( p_ < end_ && *p_ == ' ' )
+        ++p_;
+    while( end_ > p_ && ( end_[ -1 ] == ' ' || end_[ -1 ] == '\r' ) )
+        --end_;
+    if( end_ - p_ < 3 || ( *p_ != '*' && *p_ != '_' ) )
+        return false;
+    for( const char* q = p_; q < end_; ++q )
+    {
+        if( *q != *p_ )
+            return false;
+    }
+    return true;
+}
+
+// Paragraph and list lines. Lines are kept as the preview shows them: consecutive lines with the
+// same indent form one paragraph with line breaks, "  * " starts a list item two spaces per level.
+static void AppendTextBlock( std::string& out_, const char* p_, const char* end_ )
+{
+    int paragraphIndent = -1;           // indent of the open <p>, -1 if none
+    int listDepth = 0;
+    while( p_ < end_ )
+    {
+        const char* lineEnd = (const char*)memchr( p_, '\n', end_ - p_ );
+        if( !lineEnd )
+            lineEnd = end_;
+        const char* text = p_;
+        while( text < lineEnd && *text == ' ' )
+            ++text;
+        const int lead = (int)( text - p_ );
+        const bool blank = text == lineEnd || ( *text == '\r' && text + 1 == lineEnd );
+        const bool rule = !blank && IsRule( text, lineEnd );
+        const bool item = !blank && !rule && lead >= 2 && *text == '*' && text + 1 < lineEnd && text[ 1 ] == ' ';
+
+        if( paragraphIndent >= 0 && ( blank || rule || item || lead / 2 != paragraphIndent ) )
+        {
+            out_ += "</p>\n";
+            paragraphIndent = -1;
+        }
+        // the item of each open level stays open, so a deeper list nests inside it
+        const int depth = item ? lead / 2 : 0;
+        for( ; listDepth > depth; --listDepth )
+            out_ += "</li>\n</ul>\n";
+        if( item && listDepth == depth )
+            out_ += "</li>\n";
+        for( ; listDepth < depth; ++listDepth )
+            out_ += "<ul>\n";
+
+        if( rule )
+            out_ += "<hr>\n";
+        else if( item )
+        {
+            out_ += "<li>";
+            AppendInline( out_, text + 2, lineEnd );
+        }
+        else if( !blank )
+        {
+            if( paragraphIndent < 0 )
+            {
+                paragraphIndent = lead / 2;
+                if( paragraphIndent > 0 )
+                {
+                    char open[ 48 ];
+                    snprintf( open, sizeof( open ), "<p style=\"margin-left:%dem\">", paragraphIndent * 2 );
+                    out_ += open;
+                }
+                else
+                    out_ += "<p>";
+            }
+            else
+                out_ += "<br>\n";
+            AppendInline( out_, text, lineEnd );
+        }
+        p_ = lineEnd < end_ ? lineEnd + 1 : end_;
+    }
+    if( paragraphIndent >= 0 )
+        out_ += "</p>\n";
+    for( ; listDepth > 0; --listDepth )
+        out_ += "</li>\n</ul>\n";
+}
+
+static void AppendCodeBlock( std::string& out_, const ImGui::MarkdownDocument& doc_, const ImGui::MarkdownBlock& block_ )
+{
+    const char* text = doc_.Text();
+    const char* info = text + block_.start;
+    while( *info == ' ' || *info == '`' || *info == '~' )
+        ++info;
+    const char* infoEnd = info;
+    while( infoEnd < text + block_.contentStart && *infoEnd != ' ' && *infoEnd != '\n' && *infoEnd != '\r' && *infoEnd != '{' )
+        ++infoEnd;
+    if( infoEnd > info )
+    {
+        out_ += "<pre><code class=\"language-";
+        AppendEscaped( out_, info, infoEnd );
+        out_ += "\">";
+    }
+    else
+        out_ += "<pre><code>";
+
+    ImGui::MarkdownBlockCache cache;
+    ImGui::BuildCodeCache( doc_, block_, cache );
+    const char* base = text + block_.contentStart;
+    const char* end = text + block_.contentStop;
+    const char* line = base;
+    for( int l = 0; l + 1 < cache.lineRuns.Size; ++l )
+    {
+        const char* lineEnd = (const char*)memchr( line, '\n', end - line );
+        if( !lineEnd )
+            lineEnd = end;
+        const char* p = line;
+        for( int r = cache.lineRuns[ l ]; r < cache.lineRuns[ l + 1 ]; ++r )
+        {
+            const SyntaxRun& run = cache.runs[ r ];
+            AppendEscaped( out_, p, base + run.start );
+            const char* cls = TokenClass( run.token );
+            if( cls )
+            {
+                out_ += "<span class=\"";
+                out_ += cls;
+                out_ += "\">";
+            }
+            AppendEscaped( out_, base + run.start, base + run.start + run.length );
+            if( cls )
+                out_ += "</span>";
+            p = base + run.start + run.length;
+        }
+        AppendEscaped( out_, p, lineEnd );
+        if( lineEnd < end )
+            out_ += '\n';
+        line = lineEnd < end ? lineEnd + 1 : end;
+    }
+    out_ += "</code></pre>\n";
+}
+
+static void AppendTable( std::string& out_, const ImGui::MarkdownDocument& doc_, const ImGui::MarkdownBlock& block_ )
+{
+    ImGui::MarkdownBlockCache cache;
+    ImGui::BuildTableCache( doc_, block_, cache );
+    if( cache.columns == 0 )
+        return;
+    const char* base = doc_.Text() + block_.start;
+    const int rows = cache.cells.Size / ( cache.columns * 2 );
+    out_ += "<table>\n";
+    for( int row = 0; row < rows; ++row )
+    {
+        out_ += row == 0 ? "<thead><tr>" : "<tr>";
+        for( int c = 0; c < cache.columns; ++c )
+        {
+            const char align = c < cache.align.Size ? cache.align[ c ] : 'l';
+            out_ += row == 0 ? "<th" : "<td";
+            out_ += align == 'c' ? " align=\"center\">" : align == 'r' ? " align=\"right\">" : ">";
+            const int* cell = &cache.cells[ ( row * cache.columns + c ) * 2 ];
+            AppendInline( out_, base + cell[ 0 ], base + cell[ 1 ] );
+            out_ += row == 0 ? "</th>" : "</td>";
+        }
+        out_ += row == 0 ? "</tr></thead>\n<tbody>\n" : "</tr>\n";
+    }
+    out_ += rows > 1 ? "</tbody>\n</table>\n" : "<tbody>\n</tbody>\n</table>\n";
+}
+
+void RenderHtmlBlocks( const ImGui::MarkdownDocument& doc_, int fromBlock_, int toBlock_, std::string& out_ )
+{
+    const char* text = doc_.Text();
+    for( int i = fromBlock_; i < toBlock_; ++i )
+    {
+        const ImGui::MarkdownBlock& block = doc_.blocks[ i ];
+        switch( block.type )
+        {
+        case ImGui::MarkdownBlockType::HEADING:
+        {
+            const char* p = text + block.start;
+            const char* end = text + block.stop;
+            while( p < end && ( *p == ' ' || *p == '#' ) )
+                ++p;
+            while( end > p && ( end[ -1 ] == '\n' || end[ -1 ] == '\r' || end[ -1 ] == ' ' ) )
+                --end;
+            static const char* const tags[] = { "h1>", "h2>", "h3>", "h4>", "h5>", "h6>" };
+            const char* tag = tags[ block.level < 1 ? 0 : block.level < 6 ? block.level - 1 : 5 ];
+            out_ += '<';
+            out_ += tag;
+            AppendEscaped( out_, p, end );
+            out_ += "</";
+            out_ += tag;
+            out_ += '\n';
+            break;
+        }
+        case ImGui::MarkdownBlockType::CODE:
+            AppendCodeBlock( out_, doc_, block );
+            break;
+        case ImGui::MarkdownBlockType::TABLE:
+            AppendTable( out_, doc_, block );
+            break;
+        default:
+            AppendTextBlock( out_, text + block.start, text + block.stop );
+            break;
+        }
+    }
+}
+
+static bool WriteAll( int fd_, std::vector<struct iovec>& parts_ )
+{
+    size_t first = 0;
+    while( first < parts_.size() )
+    {
+        int count = parts_.size() - first < IOV_MAX ? (int)( parts_.size() - first ) : IOV_MAX;
+        ssize_t written = writev( fd_, &parts_[ first ], count );
+        if( written < 0 )
+        {
+            if( errno == EINTR )
+                continue;
+            return false;
+        }
+        // skip what was written, a partial write leaves the rest of a piece
+        while( first < parts_.size() && (size_t)written >= parts_[ first ].iov_len )
+            written -= parts_[ first++ ].iov_len;
+        if( first < parts_.size() )
+        {
+            parts_[ first ].iov_base = (char*)parts_[ first ].iov_base + written;
+            parts_[ first ].iov_len -= written;
+        }
+    }
+    return true;
+}
+
+bool ExportHtml( const ImGui::MarkdownDocument& doc_, const char* path_, const char* title_ )
+{
+    // cut between blocks, about HTMLRANGEBYTES of source per range
+    std::vector<int> cuts( 1, 0 );
+    for( int i = 0, start = 0; i < doc_.blocks.Size; ++i )
+    {
+        if( doc_.blocks[ i ].stop - start >= HTMLRANGEBYTES || i + 1 == doc_.blocks.Size )
+        {
+            cuts.push_back( i + 1 );
+            start = doc_.blocks[ i ].stop;
+        }
+    }
+    const int ranges = (int)cuts.size() - 1;
+    std::vector<std::string> pieces( ranges + 2 );
+    auto body = [ & ]( int begin_, int end_ )
+    {
+        for( int r = begin_; r < end_; ++r )
+        {
+            pieces[ r + 1 ].reserve( ( doc_.blocks[ cuts[ r + 1 ] - 1 ].stop - doc_.blocks[ cuts[ r ] ].start ) * 5 / 4 );
+            RenderHtmlBlocks( doc_, cuts[ r ], cuts[ r + 1 ], pieces[ r + 1 ] );
+        }
+    };
+    if( ranges > 1 )
+        ThreadPool::Shared().ParallelFor( ranges, 1, body );
+    else
+        body( 0, ranges );
+
+    std::string& head = pieces.front();
+    head = "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>";
+    AppendEscaped( head, title_, title_ + strlen( title_ ) );
+    head += "</title>\n<style>\n"
+        "body { max-width: 60em; margin: 2em auto; padding: 0 1em; font-family: sans-serif; line-height: 1.5; }\n"
+        "pre { background: #1e1e1e; color: #d4d4d4; padding: 0.8em; overflow-x: auto; }\n"
+        "table { border-collapse: collapse; } th, td { border: 1px solid #888; padding: 0.2em 0.6em; }\n";
+    static const SyntaxToken tokens[] = { SYNTAX_KEYWORD, SYNTAX_STRING, SYNTAX_NUMBER, SYNTAX_COMMENT, SYNTAX_PREPROCESSOR };
+    for( SyntaxToken token : tokens )
+    {
+        // same colors as the preview
+        ImU32 color = SyntaxColor( token );
+        char rule[ 64 ];
+        snprintf( rule, sizeof( rule ), ".%s { color: #%02x%02x%02x; }\n", TokenClass( token ),
+            (unsigned)( color >> IM_COL32_R_SHIFT ) & 0xFF, (unsigned)( color >> IM_COL32_G_SHIFT ) & 0xFF, (unsigned)( color >> IM_COL32_B_SHIFT ) & 0xFF );
+        head += rule;
+    }
+    head += "</style>\n</head>\n<body>\n";
+    pieces.back() = "</body>\n</html>\n";
+
+    std::vector<struct iovec> parts;
+    for( std::string& piece : pieces )
+    {
+        if( !piece.empty() )
+            parts.push_back( { (void*)piece.data(), piece.size() } );
+    }
+    int fd = open( path_, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( fd < 0 )
+        return false;
+    bool ok = WriteAll( fd, parts );
+    return close( fd ) == 0 && ok;
+}
+
+bool ExportHtmlFile( const char* mdPath_, const char* htmlPath_ )
+{
+    int fd = open( mdPath_, O_RDONLY );
+    if( fd < 0 )
+        return false;
+    struct stat st;
+    std::vector<char> text;
+    bool ok = fstat( fd, &st ) == 0;
+    if( ok )
+    {
+        text.resize( (size_t)st.st_size );
+        for( size_t done = 0; ok && done < text.size(); )
+        {
+            ssize_t got = read( fd, text.data() + done, text.size() - done );
+            if( got < 0 && errno == EINTR )
+                continue;
+            ok = got > 0;
+            done += got > 0 ? (size_t)got : 0;
+        }
+    }
+    close( fd );
+    if( !ok )
+        return false;
+
+    ImGui::MarkdownDocument doc;
+    doc.SetText( text.data(), text.size() );
+    // the first H1 names the page, else the file
+    std::string title;
+    if( doc.headings.Size > 0 && doc.headings[ 0 ].level == 1 )
+        title.assign( doc.Text() + doc.headings[ 0 ].textStart, doc.headings[ 0 ].textStop - doc.headings[ 0 ].textStart );
+    else
+    {
+        const char* slash = strrchr( mdPath_, '/' );
+        title = slash ? slash + 1 : mdPath_;
+    }
+    return ExportHtml( doc, htmlPath_, title.c_str() );
+}
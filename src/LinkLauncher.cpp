@@ -0,0 +1,220 @@
+#include "LinkLauncher.h"
+#include "imgui.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <string.h>
+
+#ifdef WIN32
+#include <Windows.h>
+#include "Shellapi.h"
+#else
+#include <errno.h>
+#include <spawn.h>
+#include <signal.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace
+{
+    struct LinkStatus {
+        enum State {
+            OPENING,
+            OPENED,
+            FAILED,
+        };
+        int         id = 0;
+        std::string url;
+        State       state = OPENING;
+        std::string error;
+        double      doneTime = 0.0;
+    };
+
+    double Now()
+    {
+        return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
+    struct LinkLauncher {
+        std::mutex              mutex;
+        std::condition_variable cond;
+        std::thread             worker;
+        std::deque<LinkStatus>  requests;
+        std::vector<LinkStatus> status;             // shown by ShowLinkStatus()
+        bool                    stop = false;
+        int                     nextId = 0;
+
+        ~LinkLauncher()
+        {
+            if( !worker.joinable() )
+                return;
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stop = true;
+            }
+            cond.notify_one();
+            worker.join();
+        }
+
+        void Finish( int id_, LinkStatus::State state_, const std::string& error_ )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            for( size_t i = 0; i < status.size(); ++i )
+            {
+                if( status[ i ].id == id_ )
+                {
+                    status[ i ].state = state_;
+                    status[ i ].error = error_;
+                    status[ i ].doneTime = Now();
+                }
+            }
+        }
+
+        void WorkerMain()
+        {
+#ifndef WIN32
+            struct Child { pid_t pid; int id; };
+            std::vector<Child> children;
+#endif
+            std::unique_lock<std::mutex> lock( mutex );
+            for( ;; )
+            {
+#ifdef WIN32
+                cond.wait( lock, [this] { return stop || !requests.empty(); } );
+#else
+                // while handlers are running, wake up regularly to reap them
+                if( children.empty() )
+                    cond.wait( lock, [this] { return stop || !requests.empty(); } );
+                else
+                    cond.wait_for( lock, std::chrono::milliseconds( 100 ), [this] { return stop || !requests.empty(); } );
+#endif
+                if( stop )
+                    break;
+                std::deque<LinkStatus> batch;
+                batch.swap( requests );
+                lock.unlock();
+
+                for( size_t i = 0; i < batch.size(); ++i )
+                {
+                    const LinkStatus& req = batch[ i ];
+#ifdef WIN32
+                    HINSTANCE res = ShellExecuteA( NULL, "open", req.url.c_str(), NULL, NULL, SW_SHOWNORMAL );
+                    if( (INT_PTR)res > 32 )
+                        Finish( req.id, LinkStatus::OPENED, "" );
+                    else
+                        Finish( req.id, LinkStatus::FAILED, "ShellExecute failed" );
+#else
+                    char* argv[] = { (char*)"xdg-open", (char*)req.url.c_str(), NULL };
+                    pid_t pid = 0;
+                    int err = posix_spawnp( &pid, "xdg-open", NULL, NULL, argv, environ );
+                    if( err != 0 )
+                        Finish( req.id, LinkStatus::FAILED, std::string( "xdg-open: " ) + strerror( err ) );
+                    else
+                        children.push_back( { pid, req.id } );
+#endif
+                }
+
+#ifndef WIN32
+                for( size_t i = 0; i < children.size(); )
+                {
+                    int wstatus = 0;
+                    pid_t res = waitpid( children[ i ].pid, &wstatus, WNOHANG );
+                    if( res == 0 )
+                    {
+                        ++i;
+                        continue;
+                    }
+                    if( res < 0 )
+                        Finish( children[ i ].id, LinkStatus::FAILED, strerror( errno ) );
+                    else if( WIFEXITED( wstatus ) && WEXITSTATUS( wstatus ) == 0 )
+                        Finish( children[ i ].id, LinkStatus::OPENED, "" );
+                    else
+                        Finish( children[ i ].id, LinkStatus::FAILED, "xdg-open exited with status " + std::to_string( WIFEXITED( wstatus ) ? WEXITSTATUS( wstatus ) : -1 ) );
+                    children.erase( children.begin() + i );
+                }
+#endif
+                lock.lock();
+            }
+        }
+    };
+
+    LinkLauncher launcher;
+}
+
+void OpenLinkAsync( const char* url_, int length_ )
+{
+    LinkStatus req;
+    req.url.assign( url_, (size_t)length_ );
+    {
+        std::lock_guard<std::mutex> lock( launcher.mutex );
+        req.id = ++launcher.nextId;
+        if( req.url.empty() || req.url[ 0 ] == '-' )
+        {
+            // would be parsed as an option by the handler
+            req.state = LinkStatus::FAILED;
+            req.error = "refusing to open this link";
+            req.doneTime = Now();
+            launcher.status.push_back( req );
+            return;
+        }
+        launcher.status.push_back( req );
+        launcher.requests.push_back( req );
+        if( !launcher.worker.joinable() )
+            launcher.worker = std::thread( &LinkLauncher::WorkerMain, &launcher );
+    }
+    launcher.cond.notify_one();
+}
+
+void ShowLinkStatus()
+{
+    const double OpenedSeconds = 1.0;       // how long an opened link stays listed
+    const double FailedSeconds = 5.0;
+
+    std::vector<LinkStatus> shown;
+    {
+        std::lock_guard<std::mutex> lock( launcher.mutex );
+        double now = Now();
+        for( size_t i = 0; i < launcher.status.size(); )
+        {
+            const LinkStatus& s = launcher.status[ i ];
+            double keep = s.state == LinkStatus::OPENED ? OpenedSeconds : FailedSeconds;
+            if( s.state != LinkStatus::OPENING && now - s.doneTime > keep )
+            {
+                launcher.status.erase( launcher.status.begin() + i );
+                continue;
+            }
+            shown.push_back( s );
+            ++i;
+        }
+    }
+    if( shown.empty() )
+        return;
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImVec2 pos( viewport->WorkPos.x + viewport->WorkSize.x - 10.0f, viewport->WorkPos.y + viewport->WorkSize.y - 10.0f );
+    ImGui::SetNextWindowPos( pos, ImGuiCond_Always, ImVec2( 1.0f, 1.0f ) );
+    ImGui::SetNextWindowViewport( viewport->ID );
+    ImGui::SetNextWindowBgAlpha( 0.8f );
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDocking
+        | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+    if( ImGui::Begin( "##LinkStatus", NULL, flags ) )
+    {
+        for( size_t i = 0; i < shown.size(); ++i )
+        {
+            const LinkStatus& s = shown[ i ];
+            if( s.state == LinkStatus::OPENING )
+                ImGui::Text( "Opening %s...", s.url.c_str() );
+            else if( s.state == LinkStatus::OPENED )
+                ImGui::TextDisabled( "Opened %s", s.url.c_str() );
+            else
+                ImGui::TextColored( ImVec4( 1.0f, 0.4f, 0.4f, 1.0f ), "Cannot open %s: %s", s.url.c_str(), s.error.c_str() );
+        }
+    }
+    ImGui::End();
+}
@@ -1,19 +1,21 @@
 #include "LoadImage.h"
+#include "Profiler.h"
+#ifndef LOADIMAGE_NO_OPENGL
 #include "imgui_impl_opengl3_loader.h"
+#endif
+
+#include <map>
+#include <string>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
-// Simple helper function to load an image into a OpenGL texture with common settings
-bool LoadTextureFromFile(const char* filename, GLuint* out_texture, int* out_width, int* out_height)
-{
-    // Load from file
-    int image_width = 0;
-    int image_height = 0;
-    unsigned char* image_data = stbi_load(filename, &image_width, &image_height, NULL, 4);
-    if (image_data == NULL)
-        return false;
+#ifndef LOADIMAGE_NO_OPENGL
+#define GL_CLAMP_TO_EDGE 0x812F
 
+// Simple helper function to upload an image into a OpenGL texture with common settings
+static ImTextureID CreateGLTexture(const unsigned char* rgba, int image_width, int image_height)
+{
     // Create a OpenGL texture identifier
     GLuint image_texture;
     glGenTextures(1, &image_texture);
@@ -31,11 +33,96 @@ bool LoadTextureFromFile(const char* filename, GLuint* out_texture, int* out_wid
 #if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 #endif
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image_data);
-    stbi_image_free(image_data);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    return (ImTextureID)(intptr_t)image_texture;
+}
+
+static void DestroyGLTexture(ImTextureID texture)
+{
+    GLuint image_texture = (GLuint)(intptr_t)texture;
+    glDeleteTextures(1, &image_texture);
+}
+
+static CreateTextureFunc createTexture = CreateGLTexture;
+static DestroyTextureFunc destroyTexture = DestroyGLTexture;
+#else
+static CreateTextureFunc createTexture = NULL;
+static DestroyTextureFunc destroyTexture = NULL;
+#endif
+
+void SetTextureFunctions(CreateTextureFunc create, DestroyTextureFunc destroy)
+{
+    createTexture = create;
+    destroyTexture = destroy;
+}
+
+bool LoadTextureFromFile(const char* filename, ImTextureID* out_texture, int* out_width, int* out_height)
+{
+    ProfileTimer timer(PROFILE_LOADTEXTURE);
+    // Load from file
+    int image_width = 0;
+    int image_height = 0;
+    if (!createTexture)
+        return false;
+    unsigned char* image_data = stbi_load(filename, &image_width, &image_height, NULL, 4);
+    if (image_data == NULL)
+        return false;
 
-    *out_texture = image_texture;
+    *out_texture = createTexture(image_data, image_width, image_height);
+    stbi_image_free(image_data);
     *out_width = image_width;
     *out_height = image_height;
-    return true;
+    return *out_texture != 0;
+}
+
+struct CachedTexture
+{
+    ImTextureID texture = 0;    // 0 when the file could not be loaded
+    int width = 0;
+    int height = 0;
+    int lastFrame = 0;
+};
+
+static std::map<std::string, CachedTexture> textureCache;
+
+bool GetCachedTexture(const char* filename, ImTextureID* out_texture, int* out_width, int* out_height)
+{
+    std::map<std::string, CachedTexture>::iterator it = textureCache.find(filename);
+    if (it == textureCache.end())
+    {
+        CachedTexture entry;
+        LoadTextureFromFile(filename, &entry.texture, &entry.width, &entry.height);
+        it = textureCache.insert(std::make_pair(std::string(filename), entry)).first;
+    }
+    it->second.lastFrame = ImGui::GetFrameCount();
+    *out_texture = it->second.texture;
+    *out_width = it->second.width;
+    *out_height = it->second.height;
+    return it->second.texture != 0;
+}
+
+void CollectTextures(int idle_frames)
+{
+    int frame = ImGui::GetFrameCount();
+    for (std::map<std::string, CachedTexture>::iterator it = textureCache.begin(); it != textureCache.end(); )
+    {
+        if (frame - it->second.lastFrame <= idle_frames)
+        {
+            ++it;
+            continue;
+        }
+        if (it->second.texture && destroyTexture)
+            destroyTexture(it->second.texture);
+        it = textureCache.erase(it);
+    }
+}
+
+void ReleaseTextures()
+{
+    for (std::map<std::string, CachedTexture>::iterator it = textureCache.begin(); it != textureCache.end(); ++it)
+    {
+        if (it->second.texture && destroyTexture)
+            destroyTexture(it->second.texture);
+    }
+    textureCache.clear();
 }
@@ -0,0 +1,1116 @@
+#include "MarkdownDocument.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <ctype.h>
+#include <algorithm>
+
+namespace ImGui
+{
+    static bool IsBlankLine( const char* line_, const char* lineEnd_ )
+    {
+        for( ; line_ < lineEnd_; ++line_ ) {
+            if( *line_ != ' ' && *line_ != '\t' && *line_ != '\r' ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Same rule as the line renderer: optional leading spaces, one or more '#', then a space
+    static int HeadingLevel( const char* line_, const char* lineEnd_ )
+    {
+        while( line_ < lineEnd_ && *line_ == ' ' ) { ++line_; }
+        int level = 0;
+        while( line_ < lineEnd_ && *line_ == '#' ) { ++line_; ++level; }
+        if( level > 0 && line_ < lineEnd_ && *line_ == ' ' ) {
+            return level;
+        }
+        return 0;
+    }
+
+    // Opening or closing code fence: up to 3 spaces, then at least 3 '`' or '~'.
+    // Returns the fence length and sets *fenceChar_, 0 if the line is not a fence.
+    static int FenceLength( const char* line_, const char* lineEnd_, char* fenceChar_ )
+    {
+        int indent = 0;
+        while( line_ < lineEnd_ && *line_ == ' ' && indent < 4 ) { ++line_; ++indent; }
+        if( indent > 3 || line_ == lineEnd_ || ( *line_ != '`' && *line_ != '~' ) ) {
+            return 0;
+        }
+        char c = *line_;
+        int  length = 0;
+        while( line_ < lineEnd_ && *line_ == c ) { ++line_; ++length; }
+        if( length < 3 ) {
+            return 0;
+        }
+        *fenceChar_ = c;
+        return length;
+    }
+
+    static bool IsClosingFence( const char* line_, const char* lineEnd_, char fenceChar_, int fenceLength_ )
+    {
+        char c = 0;
+        int  length = FenceLength( line_, lineEnd_, &c );
+        if( c != fenceChar_ || length < fenceLength_ ) {
+            return false;
+        }
+        while( *line_ == ' ' ) { ++line_; }
+        return IsBlankLine( line_ + length, lineEnd_ );
+    }
+
+    // Splits a table row into cells (start and stop offsets from base_). Leading and trailing
+    // pipes are optional, "\\|" does not separate cells, cell text is trimmed.
+    static int SplitTableRow( const char* base_, const char* line_, const char* lineEnd_, ImVector<int>* cells_ )
+    {
+        while( line_ < lineEnd_ && ( *line_ == ' ' || *line_ == '\t' ) ) { ++line_; }
+        while( lineEnd_ > line_ && ( lineEnd_[ -1 ] == ' ' || lineEnd_[ -1 ] == '\t' || lineEnd_[ -1 ] == '\r' ) ) { --lineEnd_; }
+        if( line_ < lineEnd_ && *line_ == '|' ) {
+            ++line_;
+        }
+        if( lineEnd_ > line_ && lineEnd_[ -1 ] == '|' && ( lineEnd_ - 1 == line_ || lineEnd_[ -2 ] != '\\' ) ) {
+            --lineEnd_;
+        }
+        int count = 0;
+        const char* cell = line_;
+        for( const char* p = line_; p <= lineEnd_; ++p ) {
+            if( p == lineEnd_ || ( *p == '|' && ( p == line_ || p[ -1 ] != '\\' ) ) ) {
+                const char* b = cell;
+                const char* e = p;
+                while( b < e && ( *b == ' ' || *b == '\t' ) ) { ++b; }
+                while( e > b && ( e[ -1 ] == ' ' || e[ -1 ] == '\t' ) ) { --e; }
+                if( cells_ ) {
+                    cells_->push_back( (int)( b - base_ ) );
+                    cells_->push_back( (int)( e - base_ ) );
+                }
+                ++count;
+                cell = p + 1;
+            }
+        }
+        return count;
+    }
+
+    // Delimiter row under a table header, e.g. "| :--- | ---: |". Returns its column count, 0 if not one.
+    static int TableDelimiterColumns( const char* line_, const char* lineEnd_ )
+    {
+        bool hasPipe = false, hasDash = false;
+        for( const char* p = line_; p < lineEnd_; ++p ) {
+            switch( *p ) {
+                case '|': hasPipe = true; break;
+                case '-': hasDash = true; break;
+                case ':': case ' ': case '\t': case '\r': break;
+                default: return 0;
+            }
+        }
+        if( !hasPipe || !hasDash ) {
+            return 0;
+        }
+        return SplitTableRow( line_, line_, lineEnd_, NULL );
+    }
+
+    static bool IsTableRow( const char* line_, const char* lineEnd_ )
+    {
+        return !IsBlankLine( line_, lineEnd_ ) && memchr( line_, '|', lineEnd_ - line_ ) != NULL;
+    }
+
+    // Parses whole lines from pos_ and appends the blocks to out_. When old_ is given, parsing
+    // stops at the first block that starts where old block *sync_ (shifted by delta_) starts:
+    // from there on the text and therefore the old blocks are unchanged. Returns true in that case.
+    static bool ParseBlocks( const char* text_, int length_, int pos_, ImVector<MarkdownBlock>& out_,
+        const ImVector<MarkdownBlock>* old_ = NULL, int* sync_ = NULL, int delta_ = 0 )
+    {
+        int open = -1;                      // index of the text block still accepting lines
+        while( pos_ < length_ ) {
+            const char* newLine = (const char*)memchr( text_ + pos_, '\n', length_ - pos_ );
+            int lineEnd = newLine ? (int)( newLine - text_ ) : length_;
+            int next    = newLine ? lineEnd + 1 : length_;
+
+            char fenceChar = 0;
+            int  fence = FenceLength( text_ + pos_, text_ + lineEnd, &fenceChar );
+            int  level = fence ? 0 : HeadingLevel( text_ + pos_, text_ + lineEnd );
+            bool table = false;
+            if( !fence && !level && next < length_ && IsTableRow( text_ + pos_, text_ + lineEnd ) ) {
+                const char* delimEnd = (const char*)memchr( text_ + next, '\n', length_ - next );
+                int columns = TableDelimiterColumns( text_ + next, delimEnd ? delimEnd : text_ + length_ );
+                table = columns > 0 && columns == SplitTableRow( text_, text_ + pos_, text_ + lineEnd, NULL );
+            }
+            bool startBlock = fence > 0 || level > 0 || table || open < 0 || out_[ open ].lineCount >= MarkdownDocument::MAXBLOCKLINES;
+            if( startBlock && old_ ) {
+                while( *sync_ < old_->Size && (*old_)[ *sync_ ].start + delta_ < pos_ ) {
+                    ++*sync_;
+                }
+                if( *sync_ < old_->Size && (*old_)[ *sync_ ].start + delta_ == pos_ ) {
+                    return true;
+                }
+            }
+
+            if( fence > 0 ) {
+                // a code block is never split: everything up to the closing fence belongs to it
+                MarkdownBlock block;
+                block.type = MarkdownBlockType::CODE;
+                block.start = pos_;
+                block.contentStart = next;
+                block.lineCount = 1;
+                int line = next;
+                block.contentStop = block.stop = length_;
+                while( line < length_ ) {
+                    const char* codeNewLine = (const char*)memchr( text_ + line, '\n', length_ - line );
+                    int codeLineEnd = codeNewLine ? (int)( codeNewLine - text_ ) : length_;
+                    int codeNext    = codeNewLine ? codeLineEnd + 1 : length_;
+                    ++block.lineCount;
+                    if( IsClosingFence( text_ + line, text_ + codeLineEnd, fenceChar, fence ) ) {
+                        block.contentStop = line;
+                        block.stop = codeNext;
+                        break;
+                    }
+                    line = codeNext;
+                }
+                out_.push_back( block );
+                open = -1;
+                next = block.stop;
+            }
+            else if( table ) {
+                // like code blocks, tables are never split; they end at the first line without a pipe
+                MarkdownBlock block;
+                block.type = MarkdownBlockType::TABLE;
+                block.start = pos_;
+                block.lineCount = 1;
+                int line = next;
+                while( line < length_ ) {
+                    const char* rowNewLine = (const char*)memchr( text_ + line, '\n', length_ - line );
+                    int rowEnd  = rowNewLine ? (int)( rowNewLine - text_ ) : length_;
+                    char fenceChar = 0;
+                    if( block.lineCount > 1 && ( !IsTableRow( text_ + line, text_ + rowEnd )
+                            || HeadingLevel( text_ + line, text_ + rowEnd ) || FenceLength( text_ + line, text_ + rowEnd, &fenceChar ) ) ) {
+                        break;
+                    }
+                    ++block.lineCount;
+                    line = rowNewLine ? rowEnd + 1 : length_;
+                }
+                block.stop = line;
+                out_.push_back( block );
+                open = -1;
+                next = block.stop;
+            }
+            else if( level > 0 ) {
+                MarkdownBlock block;
+                block.type = MarkdownBlockType::HEADING;
+                block.start = pos_;
+                block.stop = next;
+                block.lineCount = 1;
+                block.level = level;
+                out_.push_back( block );
+                open = -1;
+            }
+            else {
+                if( startBlock ) {
+                    MarkdownBlock block;
+                    block.start = pos_;
+                    out_.push_back( block );
+                    open = out_.Size - 1;
+                }
+                out_[ open ].stop = next;
+                ++out_[ open ].lineCount;
+                if( IsBlankLine( text_ + pos_, text_ + lineEnd ) ) {
+                    open = -1;              // a blank line closes the paragraph
+                }
+            }
+            pos_ = next;
+        }
+        return false;
+    }
+
+    MarkdownEdit DiffText( const char* old_, int oldLength_, const char* new_, int newLength_, int sameHead_, int sameTail_ )
+    {
+        int common = ImMin( oldLength_, newLength_ );
+        int prefix = ImClamp( sameHead_, 0, common );
+        while( prefix < common && old_[ prefix ] == new_[ prefix ] ) {
+            ++prefix;
+        }
+        int suffix = ImClamp( sameTail_, 0, common - prefix );
+        while( suffix < common - prefix && old_[ oldLength_ - 1 - suffix ] == new_[ newLength_ - 1 - suffix ] ) {
+            ++suffix;
+        }
+        MarkdownEdit edit;
+        edit.pos = prefix;
+        edit.deleteLength = oldLength_ - prefix - suffix;
+        edit.insertLength = newLength_ - prefix - suffix;
+        return edit;
+    }
+
+    void MarkdownDocument::SetText( const char* text_, size_t length_ )
+    {
+        buf.resize( (int)length_ + 1 );
+        if( length_ ) {
+            memcpy( buf.Data, text_, length_ );
+        }
+        buf[ (int)length_ ] = 0;
+        unloaded = false;
+        Derive();
+    }
+
+    void MarkdownDocument::Derive()
+    {
+        if( trackEdits ) {
+            committed.resize( Length() );
+            if( Length() ) {
+                memcpy( committed.Data, buf.Data, (size_t)Length() );
+            }
+        }
+        lineStarts.resize( 1 );
+        lineStarts[ 0 ] = 0;
+        lineStates.resize( 1 );
+        lineStates[ 0 ] = MarkdownLineState();
+        statesKnown = 1;
+        statesCached = 0;
+        UpdateLineStarts( { 0, 0, Length() } );
+        Parse( 0 );
+    }
+
+    void MarkdownDocument::Append( const char* text_, size_t length_ )
+    {
+        if( length_ == 0 ) {
+            return;
+        }
+        Restore();
+        int oldLength = Length();
+        buf.resize( oldLength + (int)length_ + 1 );
+        memcpy( buf.Data + oldLength, text_, length_ );
+        buf[ oldLength + (int)length_ ] = 0;
+        if( trackEdits ) {
+            committed.resize( oldLength + (int)length_ );
+            memcpy( committed.Data + oldLength, text_, length_ );
+        }
+        UpdateLineStarts( { oldLength, 0, (int)length_ } );
+
+        // the last block may end in the middle of a line or paragraph, so it is parsed again
+        Parse( blocks.Size > 0 ? blocks.Size - 1 : 0 );
+    }
+
+    void MarkdownDocument::Parse( int fromBlock_ )
+    {
+        if( fromBlock_ > blocks.Size ) {
+            fromBlock_ = blocks.Size;
+        }
+        int pos = 0;
+        if( fromBlock_ < blocks.Size ) {
+            pos = blocks[ fromBlock_ ].start;
+        }
+        else if( fromBlock_ > 0 ) {
+            pos = blocks[ fromBlock_ - 1 ].stop;
+        }
+        ReleaseCaches( fromBlock_, blocks.Size );
+        while( headings.Size > 0 && headings.back().block >= fromBlock_ ) {
+            headings.pop_back();
+        }
+        blocks.resize( fromBlock_ );
+        ParseBlocks( buf.Data, Length(), pos, blocks );
+        AddHeadings( fromBlock_, blocks.Size );
+        layoutDirty = ImMin( layoutDirty, fromBlock_ );
+    }
+
+    void MarkdownDocument::Reparse( const MarkdownEdit& edit_ )
+    {
+        if( edit_.IsEmpty() ) {
+            return;
+        }
+        // a heading turned into text can join the paragraph above, so start one block earlier
+        int first = FindBlockAt( edit_.pos );
+        if( first > 0 ) {
+            --first;
+        }
+        int start = first < blocks.Size ? blocks[ first ].start : 0;
+        int oldEnd = edit_.pos + edit_.deleteLength;
+        int delta = edit_.insertLength - edit_.deleteLength;
+        int sync = FindBlockAt( oldEnd );
+        while( sync < blocks.Size && blocks[ sync ].start < oldEnd ) {
+            ++sync;
+        }
+
+        ImVector<MarkdownBlock> fresh;
+        if( !ParseBlocks( buf.Data, Length(), start, fresh, &blocks, &sync, delta ) ) {
+            sync = blocks.Size;
+        }
+
+        // blocks after the sync point keep their measured heights and caches, they only move
+        ReleaseCaches( first, sync );
+        ImVector<MarkdownBlock> merged;
+        merged.reserve( first + fresh.Size + blocks.Size - sync );
+        for( int i = 0; i < first; ++i ) {
+            merged.push_back( blocks[ i ] );
+        }
+        for( int i = 0; i < fresh.Size; ++i ) {
+            merged.push_back( fresh[ i ] );
+        }
+        for( int i = sync; i < blocks.Size; ++i ) {
+            MarkdownBlock block = blocks[ i ];
+            block.start += delta;
+            block.stop += delta;
+            block.contentStart += delta;
+            block.contentStop += delta;
+            merged.push_back( block );
+        }
+        blocks.swap( merged );
+        layoutDirty = ImMin( layoutDirty, first );
+
+        // same splice on the outline: drop the re-parsed headings, renumber the ones after
+        int shift = fresh.Size - ( sync - first );
+        int keep = 0;
+        while( keep < headings.Size && headings[ keep ].block < first ) {
+            ++keep;
+        }
+        ImVector<MarkdownHeading> after;
+        for( int i = keep; i < headings.Size; ++i ) {
+            if( headings[ i ].block >= sync ) {
+                MarkdownHeading heading = headings[ i ];
+                heading.block += shift;
+                heading.textStart += delta;
+                heading.textStop += delta;
+                after.push_back( heading );
+            }
+        }
+        headings.resize( keep );
+        AddHeadings( first, first + fresh.Size );
+        int added = headings.Size;
+        headings.resize( added + after.Size );
+        for( int i = 0; i < after.Size; ++i ) {
+            headings[ added + i ] = after[ i ];
+        }
+    }
+
+    MarkdownEdit MarkdownDocument::CommitEdit( ImVector<char>* deleted_, int sameHead_, int sameTail_ )
+    {
+        IM_ASSERT( !unloaded );
+        MarkdownEdit edit = DiffText( committed.Data, committed.Size, buf.Data, Length(), sameHead_, sameTail_ );
+        if( edit.IsEmpty() ) {
+            return edit;
+        }
+        if( deleted_ ) {
+            deleted_->resize( edit.deleteLength );
+            memcpy( deleted_->Data, committed.Data + edit.pos, (size_t)edit.deleteLength );
+        }
+        // apply the same splice to the committed copy
+        int oldLength = committed.Size;
+        int tail = oldLength - edit.pos - edit.deleteLength;
+        if( edit.insertLength > edit.deleteLength ) {
+            committed.resize( oldLength + edit.insertLength - edit.deleteLength );
+        }
+        memmove( committed.Data + edit.pos + edit.insertLength, committed.Data + edit.pos + edit.deleteLength, (size_t)tail );
+        memcpy( committed.Data + edit.pos, buf.Data + edit.pos, (size_t)edit.insertLength );
+        committed.resize( edit.pos + edit.insertLength + tail );
+
+        UpdateLineStarts( edit );
+        Reparse( edit );
+        return edit;
+    }
+
+    int MarkdownDocument::FindBlockAt( int offset_ ) const
+    {
+        // last block starting at or before offset_
+        int lo = 0, hi = blocks.Size;
+        while( lo < hi ) {
+            int mid = ( lo + hi ) / 2;
+            if( blocks[ mid ].start <= offset_ ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo > 0 ? lo - 1 : 0;
+    }
+
+    // Splices the line index for an edit already applied to buf: line starts inside the deleted
+    // range go away, the inserted text adds its own and later lines move by the size change
+    void MarkdownDocument::UpdateLineStarts( const MarkdownEdit& edit_ )
+    {
+        int first = FindLineAt( edit_.pos ) + 1;
+        int last = first;
+        while( last < lineStarts.Size && lineStarts[ last ] <= edit_.pos + edit_.deleteLength ) {
+            ++last;
+        }
+        ImVector<int> added;
+        const char* text = buf.Data;
+        for( int p = edit_.pos; p < edit_.pos + edit_.insertLength; ++p ) {
+            const char* newLine = (const char*)memchr( text + p, '\n', edit_.pos + edit_.insertLength - p );
+            if( !newLine ) {
+                break;
+            }
+            p = (int)( newLine - text );
+            added.push_back( p + 1 );
+        }
+
+        const int delta = edit_.insertLength - edit_.deleteLength;
+        const int tail = lineStarts.Size - last;
+        const int size = first + added.Size + tail;
+        if( size > lineStarts.Size ) {
+            lineStarts.resize( size );
+        }
+        memmove( lineStarts.Data + first + added.Size, lineStarts.Data + last, (size_t)tail * sizeof( int ) );
+        lineStarts.resize( size );
+        for( int i = 0; i < added.Size; ++i ) {
+            lineStarts[ first + i ] = added[ i ];
+        }
+        for( int i = first + added.Size; i < size; ++i ) {
+            lineStarts[ i ] += delta;
+        }
+
+        // the coloring states move with their lines. Those after the edit are kept as a guess: once
+        // tokenizing from the edited line gives one of them again, all the following ones are right
+        const int oldStates = lineStates.Size;
+        lineStates.resize( ImMax( size, oldStates ) );
+        memmove( lineStates.Data + first + added.Size, lineStates.Data + last, (size_t)tail * sizeof( MarkdownLineState ) );
+        lineStates.resize( size );
+        for( int i = 0; i < added.Size; ++i ) {
+            lineStates[ first + i ] = MarkdownLineState();
+        }
+        const int lineDelta = added.Size - ( last - first );
+        if( statesKnown > first ) {
+            // only the exact states are kept: older guesses past them need not follow on from them
+            statesCached = statesKnown >= last ? statesKnown + lineDelta : first;
+            statesEditEnd = first + added.Size;
+            statesKnown = first;
+        }
+        else if( statesCached > first ) {
+            // an edit among the guesses: they can only be trusted again past it
+            statesCached = statesCached >= last ? statesCached + lineDelta : first;
+            statesEditEnd = statesEditEnd >= last ? statesEditEnd + lineDelta : first + added.Size;
+        }
+    }
+
+    int MarkdownDocument::FindLineAt( int offset_ ) const
+    {
+        // last line starting at or before offset_
+        int lo = 0, hi = lineStarts.Size;
+        while( lo < hi ) {
+            int mid = ( lo + hi ) / 2;
+            if( lineStarts[ mid ] <= offset_ ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo > 0 ? lo - 1 : 0;
+    }
+
+    const MarkdownLineState& MarkdownDocument::LineState( int line_ )
+    {
+        IM_ASSERT( line_ >= 0 && line_ < lineStates.Size );
+        ImVector<SyntaxRun> runs;
+        while( statesKnown <= line_ ) {
+            const int line = statesKnown - 1;
+            const int stop = line + 1 < lineStarts.Size ? lineStarts[ line + 1 ] - 1 : Length();
+            MarkdownLineState state = lineStates[ line ];
+            runs.resize( 0 );
+            HighlightMarkdownLine( buf.Data, buf.Data + lineStarts[ line ], buf.Data + stop, &state, runs );
+            if( statesKnown >= statesEditEnd && statesKnown < statesCached && state == lineStates[ statesKnown ] ) {
+                statesKnown = statesCached;     // converged: the rest did not change
+                continue;
+            }
+            lineStates[ statesKnown++ ] = state;
+        }
+        return lineStates[ line_ ];
+    }
+
+    void MarkdownDocument::UpdateLayout( float lineHeight_ )
+    {
+        if( layoutDirty > blocks.Size ) {
+            layoutDirty = blocks.Size;
+        }
+        float y = 0.0f;
+        if( layoutDirty > 0 ) {
+            const MarkdownBlock& prev = blocks[ layoutDirty - 1 ];
+            y = prev.posY + prev.height;
+        }
+        for( int i = layoutDirty; i < blocks.Size; ++i ) {
+            MarkdownBlock& block = blocks[ i ];
+            if( !block.measured ) {
+                // headings get a blank line above and a separator line below from the format callback
+                block.height = lineHeight_ * ( block.type == MarkdownBlockType::HEADING ? 3 : block.lineCount );
+            }
+            block.posY = y;
+            y += block.height;
+        }
+        totalHeight = y;
+        layoutDirty = blocks.Size;
+    }
+
+    // Appends the outline entries of the headings in blocks [fromBlock_, toBlock_)
+    void MarkdownDocument::AddHeadings( int fromBlock_, int toBlock_ )
+    {
+        for( int i = fromBlock_; i < toBlock_; ++i ) {
+            const MarkdownBlock& block = blocks[ i ];
+            if( block.type != MarkdownBlockType::HEADING ) {
+                continue;
+            }
+            MarkdownHeading heading;
+            heading.level = block.level;
+            heading.block = i;
+            const char* text = buf.Data;
+            int b = block.start;
+            while( b < block.stop && text[ b ] == ' ' ) { ++b; }
+            while( b < block.stop && text[ b ] == '#' ) { ++b; }
+            while( b < block.stop && text[ b ] == ' ' ) { ++b; }
+            int e = block.stop;
+            while( e > b && ( text[ e - 1 ] == '\n' || text[ e - 1 ] == '\r' || text[ e - 1 ] == ' ' ) ) { --e; }
+            heading.textStart = b;
+            heading.textStop = e;
+            headings.push_back( heading );
+        }
+    }
+
+    int MarkdownDocument::FindHeadingAtY( float y_ ) const
+    {
+        // last heading at or above y_, -1 if the view is above the first one
+        int lo = 0, hi = headings.Size;
+        while( lo < hi ) {
+            int mid = ( lo + hi ) / 2;
+            if( blocks[ headings[ mid ].block ].posY <= y_ ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo - 1;
+    }
+
+    MarkdownBlockCache& MarkdownDocument::GetCache( MarkdownBlock& block_ )
+    {
+        if( block_.cache < 0 ) {
+            if( freeCaches.Size > 0 ) {
+                block_.cache = freeCaches.back();
+                freeCaches.pop_back();
+            }
+            else {
+                block_.cache = (int)caches.size();
+                caches.push_back( MarkdownBlockCache() );
+            }
+        }
+        return caches[ block_.cache ];
+    }
+
+    void MarkdownDocument::ReleaseCaches( int fromBlock_, int toBlock_ )
+    {
+        for( int i = fromBlock_; i < toBlock_; ++i ) {
+            if( blocks[ i ].cache >= 0 ) {
+                cacheBytes -= caches[ blocks[ i ].cache ].Bytes();
+                caches[ blocks[ i ].cache ].Clear();
+                freeCaches.push_back( blocks[ i ].cache );
+                blocks[ i ].cache = -1;
+            }
+        }
+    }
+
+    size_t MarkdownDocument::CacheBytes() const
+    {
+        return caches.capacity() * sizeof( MarkdownBlockCache ) + (size_t)freeCaches.Capacity * sizeof( int ) + cacheBytes
+            + (size_t)blocks.Capacity * sizeof( MarkdownBlock ) + (size_t)headings.Capacity * sizeof( MarkdownHeading )
+            + (size_t)lineStarts.Capacity * sizeof( int ) + (size_t)lineStates.Capacity * sizeof( MarkdownLineState ) + (size_t)committed.Capacity;
+    }
+
+    void MarkdownDocument::DropCaches()
+    {
+        for( MarkdownBlock& block : blocks ) {
+            block.cache = -1;
+        }
+        std::vector<MarkdownBlockCache>().swap( caches );
+        freeCaches.clear();
+        cacheBytes = 0;
+    }
+
+    void MarkdownDocument::Unload()
+    {
+        if( unloaded ) {
+            return;
+        }
+        DropCaches();
+        blocks.clear();
+        headings.clear();
+        lineStarts.clear();
+        lineStates.clear();
+        committed.clear();
+        statesKnown = 1;
+        statesCached = 0;
+        statesEditEnd = 0;
+        layoutDirty = 0;
+        unloaded = true;
+    }
+
+    void MarkdownDocument::Restore()
+    {
+        if( !unloaded ) {
+            return;
+        }
+        unloaded = false;
+        Derive();
+    }
+
+    int MarkdownDocument::FindBlockAtY( float y_ ) const
+    {
+        // last block starting at or above y_
+        int lo = 0, hi = blocks.Size;
+        while( lo < hi ) {
+            int mid = ( lo + hi ) / 2;
+            if( blocks[ mid ].posY <= y_ ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo > 0 ? lo - 1 : 0;
+    }
+
+    float MarkdownDocument::LineToY( float line_ ) const
+    {
+        if( blocks.Size == 0 ) {
+            return 0.0f;
+        }
+        const int line = ImClamp( (int)line_, 0, lineStarts.Size - 1 );
+        const MarkdownBlock& block = blocks[ FindBlockAt( lineStarts[ line ] ) ];
+        const float inBlock = ( line_ - (float)FindLineAt( block.start ) ) / (float)ImMax( block.lineCount, 1 );
+        return block.posY + block.height * ImClamp( inBlock, 0.0f, 1.0f );
+    }
+
+    float MarkdownDocument::YToLine( float y_ ) const
+    {
+        if( blocks.Size == 0 ) {
+            return 0.0f;
+        }
+        const MarkdownBlock& block = blocks[ FindBlockAtY( y_ ) ];
+        const float inBlock = block.height > 0.0f ? ImClamp( ( y_ - block.posY ) / block.height, 0.0f, 1.0f ) : 0.0f;
+        return (float)FindLineAt( block.start ) + inBlock * (float)block.lineCount;
+    }
+
+    // Code span, link / image or emphasis starting at p_ and closed on the same line: returns its
+    // end and sets *token_, or NULL when p_ starts none of them
+    static const char* InlineSpanEnd( const char* line_, const char* p_, const char* lineEnd_, SyntaxToken* token_ )
+    {
+        const char c = *p_;
+        if( c == '`' ) {
+            const char* close = (const char*)memchr( p_ + 1, '`', lineEnd_ - p_ - 1 );
+            *token_ = SYNTAX_CODE;
+            return close ? close + 1 : NULL;
+        }
+        if( c == '[' || ( c == '!' && p_ + 1 < lineEnd_ && p_[ 1 ] == '[' ) ) {
+            const char* close = (const char*)memchr( p_, ']', lineEnd_ - p_ );
+            if( !close || close + 1 >= lineEnd_ || close[ 1 ] != '(' ) {
+                return NULL;
+            }
+            const char* urlEnd = (const char*)memchr( close + 2, ')', lineEnd_ - close - 2 );
+            *token_ = SYNTAX_LINK;
+            return urlEnd ? urlEnd + 1 : NULL;
+        }
+        if( c == '*' || c == '_' ) {
+            // '_' only opens at the start of a word, so snake_case stays plain
+            if( c == '_' && p_ > line_ && ( isalnum( (unsigned char)p_[ -1 ] ) || p_[ -1 ] == '_' ) ) {
+                return NULL;
+            }
+            const int count = p_ + 1 < lineEnd_ && p_[ 1 ] == c ? 2 : 1;
+            const char* q = p_ + count;
+            if( q >= lineEnd_ || *q == ' ' ) {
+                return NULL;
+            }
+            for( ++q; q + count <= lineEnd_; ++q ) {
+                if( *q == c && ( count == 1 || q[ 1 ] == c ) && q[ -1 ] != ' ' ) {
+                    *token_ = SYNTAX_EMPHASIS;
+                    return q + count;
+                }
+            }
+        }
+        return NULL;
+    }
+
+    void HighlightMarkdownLine( const char* base_, const char* line_, const char* lineEnd_, MarkdownLineState* state_, ImVector<SyntaxRun>& runs_ )
+    {
+        const int start = (int)( line_ - base_ );
+        const int length = (int)( lineEnd_ - line_ );
+        if( state_->fence ) {
+            if( IsClosingFence( line_, lineEnd_, state_->fenceChar, state_->fence ) ) {
+                AddSyntaxRun( runs_, start, length, SYNTAX_CODE );
+                *state_ = MarkdownLineState();
+            }
+            else {
+                HighlightLine( state_->lang, base_, line_, lineEnd_, &state_->code, runs_ );
+            }
+            return;
+        }
+
+        // same block rules as the parser
+        char fenceChar = 0;
+        const int fence = FenceLength( line_, lineEnd_, &fenceChar );
+        if( fence ) {
+            // the language is the first word of the info string, as in BuildCodeCache()
+            const char* info = line_;
+            while( info < lineEnd_ && ( *info == ' ' || *info == '`' || *info == '~' ) ) { ++info; }
+            const char* nameEnd = info;
+            while( nameEnd < lineEnd_ && *nameEnd != ' ' && *nameEnd != '\r' && *nameEnd != '{' ) { ++nameEnd; }
+            AddSyntaxRun( runs_, start, length, SYNTAX_CODE );
+            state_->lang = FindSyntaxLanguage( info, nameEnd );
+            state_->fence = fence;
+            state_->fenceChar = fenceChar;
+            state_->code = 0;
+            return;
+        }
+        if( HeadingLevel( line_, lineEnd_ ) ) {
+            AddSyntaxRun( runs_, start, length, SYNTAX_HEADING );
+            return;
+        }
+
+        const char* p = line_;
+        while( p < lineEnd_ && ( *p == ' ' || *p == '\t' ) ) { ++p; }
+        if( p + 1 < lineEnd_ && ( *p == '*' || *p == '-' || *p == '+' ) && p[ 1 ] == ' ' ) {
+            p += 2;
+            AddSyntaxRun( runs_, start, (int)( p - line_ ), SYNTAX_KEYWORD );
+        }
+        else {
+            p = line_;
+        }
+        while( p < lineEnd_ ) {
+            SyntaxToken token = SYNTAX_TEXT;
+            const char* end = *p == '\\' && p + 1 < lineEnd_ ? p + 2 : InlineSpanEnd( line_, p, lineEnd_, &token );
+            if( !end ) {
+                end = p + 1;
+                token = SYNTAX_TEXT;
+            }
+            AddSyntaxRun( runs_, (int)( p - base_ ), (int)( end - p ), token );
+            p = end;
+        }
+    }
+
+    void BuildCodeCache( const MarkdownDocument& doc_, const MarkdownBlock& block_, MarkdownBlockCache& cache_ )
+    {
+        const char* text = doc_.Text();
+        const char* info = text + block_.start;
+        const char* infoEnd = text + block_.contentStart;
+        while( info < infoEnd && ( *info == ' ' || *info == '`' || *info == '~' ) ) { ++info; }
+        const char* nameEnd = info;
+        while( nameEnd < infoEnd && *nameEnd != ' ' && *nameEnd != '\n' && *nameEnd != '\r' && *nameEnd != '{' ) { ++nameEnd; }
+        const SyntaxLanguage* lang = FindSyntaxLanguage( info, nameEnd );
+
+        const char* base = text + block_.contentStart;
+        const char* end = text + block_.contentStop;
+        int state = 0;
+        for( const char* line = base; line < end; ) {
+            const char* lineEnd = (const char*)memchr( line, '\n', end - line );
+            if( !lineEnd ) {
+                lineEnd = end;
+            }
+            cache_.lineRuns.push_back( cache_.runs.Size );
+            const char* visibleEnd = lineEnd > line && lineEnd[ -1 ] == '\r' ? lineEnd - 1 : lineEnd;
+            HighlightLine( lang, base, line, visibleEnd, &state, cache_.runs );
+            line = lineEnd < end ? lineEnd + 1 : end;
+        }
+        cache_.lineRuns.push_back( cache_.runs.Size );
+    }
+
+    static void RenderCodeBlock( MarkdownDocument& doc_, MarkdownBlock& block_, const MarkdownConfig& mdConfig_ )
+    {
+        MarkdownBlockCache& cache = doc_.GetCache( block_ );
+        const size_t cacheBytes = cache.Bytes();
+        if( cache.lineRuns.empty() ) {
+            BuildCodeCache( doc_, block_, cache );
+        }
+
+        if( mdConfig_.codeFont ) {
+            ImGui::PushFont( mdConfig_.codeFont );
+        }
+        ImFont* font = ImGui::GetFont();
+        float   fontSize = ImGui::GetFontSize();
+        const char* base = doc_.Text() + block_.contentStart;
+        if( cache.font != font || cache.fontSize != fontSize ) {
+            // run positions only depend on the font, so they are measured once per font and size
+            cache.runX.resize( cache.runs.Size );
+            for( int line = 0; line + 1 < cache.lineRuns.Size; ++line ) {
+                float x = 0.0f;
+                for( int r = cache.lineRuns[ line ]; r < cache.lineRuns[ line + 1 ]; ++r ) {
+                    const SyntaxRun& run = cache.runs[ r ];
+                    cache.runX[ r ] = x;
+                    x += font->CalcTextSizeA( fontSize, FLT_MAX, 0.0f, base + run.start, base + run.start + run.length ).x;
+                }
+            }
+            cache.font = font;
+            cache.fontSize = fontSize;
+        }
+        doc_.cacheBytes += cache.Bytes() - cacheBytes;
+
+        const ImGuiStyle& style = ImGui::GetStyle();
+        const int   lineCount = cache.lineRuns.Size - 1;
+        const float lineHeight = fontSize;
+        const ImVec2 padding = style.FramePadding;
+        ImVec2 pos = ImGui::GetCursorScreenPos();
+        ImVec2 size( ImGui::GetContentRegionAvail().x, lineCount * lineHeight + padding.y * 2.0f );
+        ImGui::Dummy( size );
+
+        // lines have a fixed height, so only the visible ones are drawn
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled( pos, ImVec2( pos.x + size.x, pos.y + size.y ), ImGui::GetColorU32( ImGuiCol_FrameBg ), style.FrameRounding );
+        drawList->PushClipRect( pos, ImVec2( pos.x + size.x, pos.y + size.y ), true );
+        float top = pos.y + padding.y;
+        int   firstLine = ImMax( 0, (int)( ( drawList->GetClipRectMin().y - top ) / lineHeight ) );
+        int   lastLine = ImMin( lineCount, (int)( ( drawList->GetClipRectMax().y - top ) / lineHeight ) + 1 );
+        for( int line = firstLine; line < lastLine; ++line ) {
+            float y = top + line * lineHeight;
+            for( int r = cache.lineRuns[ line ]; r < cache.lineRuns[ line + 1 ]; ++r ) {
+                const SyntaxRun& run = cache.runs[ r ];
+                drawList->AddText( font, fontSize, ImVec2( pos.x + padding.x + cache.runX[ r ], y ), SyntaxColor( run.token ),
+                    base + run.start, base + run.start + run.length );
+            }
+        }
+        if( mdConfig_.highlightCount > 0 && lastLine > firstLine ) {
+            // the document line index gives where each visible code line starts
+            const int   contentLine = doc_.FindLineAt( block_.contentStart );
+            const char* text = doc_.Text();
+            for( int line = firstLine; line < lastLine && contentLine + line < doc_.lineStarts.Size; ++line ) {
+                const int lineStart = doc_.lineStarts[ contentLine + line ];
+                const int lineStop = contentLine + line + 1 < doc_.lineStarts.Size ? doc_.lineStarts[ contentLine + line + 1 ] : doc_.Length();
+                const int* m = std::lower_bound( mdConfig_.highlights, mdConfig_.highlights + mdConfig_.highlightCount, lineStart );
+                for( ; m < mdConfig_.highlights + mdConfig_.highlightCount && *m < lineStop; ++m ) {
+                    const int e = ImMin( *m + mdConfig_.highlightLength, lineStop );
+                    float x0 = pos.x + padding.x + font->CalcTextSizeA( fontSize, FLT_MAX, 0.0f, text + lineStart, text + *m ).x;
+                    float x1 = x0 + font->CalcTextSizeA( fontSize, FLT_MAX, 0.0f, text + *m, text + e ).x;
+                    float y = top + line * lineHeight;
+                    bool current = (int)( m - mdConfig_.highlights ) == mdConfig_.currentHighlight;
+                    drawList->AddRectFilled( ImVec2( x0, y ), ImVec2( x1, y + lineHeight ),
+                        ImGui::GetColorU32( current ? ImGuiCol_PlotHistogram : ImGuiCol_TextSelectedBg, 0.6f ) );
+                }
+            }
+        }
+        drawList->PopClipRect();
+        if( mdConfig_.codeFont ) {
+            ImGui::PopFont();
+        }
+    }
+
+    void BuildTableCache( const MarkdownDocument& doc_, const MarkdownBlock& block_, MarkdownBlockCache& cache_ )
+    {
+        const char* base = doc_.Text() + block_.start;
+        const char* end = doc_.Text() + block_.stop;
+        int row = 0;
+        for( const char* line = base; line < end; ++row ) {
+            const char* lineEnd = (const char*)memchr( line, '\n', end - line );
+            if( !lineEnd ) {
+                lineEnd = end;
+            }
+            if( row == 0 ) {
+                cache_.columns = SplitTableRow( base, line, lineEnd, &cache_.cells );
+            }
+            else if( row == 1 ) {
+                // delimiter row gives the alignment of each column
+                ImVector<int> delims;
+                SplitTableRow( base, line, lineEnd, &delims );
+                for( int c = 0; c < cache_.columns; ++c ) {
+                    const char* b = base + delims[ c * 2 ];
+                    const char* e = base + delims[ c * 2 + 1 ];
+                    bool left = b < e && *b == ':';
+                    bool right = b < e && e[ -1 ] == ':';
+                    cache_.align.push_back( right ? ( left ? 'c' : 'r' ) : 'l' );
+                }
+            }
+            else {
+                // extra cells are dropped and missing cells are empty, as on GitHub
+                int first = cache_.cells.Size;
+                int count = SplitTableRow( base, line, lineEnd, &cache_.cells );
+                cache_.cells.resize( first + ImMin( count, cache_.columns ) * 2 );
+                for( ; count < cache_.columns; ++count ) {
+                    cache_.cells.push_back( 0 );
+                    cache_.cells.push_back( 0 );
+                }
+            }
+            line = lineEnd < end ? lineEnd + 1 : end;
+        }
+    }
+
+    static void RenderTableBlock( MarkdownDocument& doc_, int index_, MarkdownBlock& block_, const MarkdownConfig& mdConfig_ )
+    {
+        MarkdownBlockCache& cache = doc_.GetCache( block_ );
+        const size_t cacheBytes = cache.Bytes();
+        if( cache.cells.empty() ) {
+            BuildTableCache( doc_, block_, cache );
+        }
+        if( cache.columns <= 0 ) {
+            doc_.cacheBytes += cache.Bytes() - cacheBytes;
+            return;
+        }
+
+        // column widths are measured over every row once per table version and font,
+        // not from the rows the clipper happens to submit
+        ImFont* font = ImGui::GetFont();
+        float   fontSize = ImGui::GetFontSize();
+        const char* base = doc_.Text() + block_.start;
+        if( cache.font != font || cache.fontSize != fontSize ) {
+            const float maxWidth = fontSize * 30.0f;
+            cache.columnWidths.resize( cache.columns );
+            for( int c = 0; c < cache.columns; ++c ) {
+                cache.columnWidths[ c ] = 0.0f;
+            }
+            for( int i = 0; i + 1 < cache.cells.Size; i += 2 ) {
+                float w = font->CalcTextSizeA( fontSize, FLT_MAX, 0.0f, base + cache.cells[ i ], base + cache.cells[ i + 1 ] ).x;
+                float& column = cache.columnWidths[ ( i / 2 ) % cache.columns ];
+                column = ImMin( ImMax( column, w ), maxWidth );
+            }
+            cache.font = font;
+            cache.fontSize = fontSize;
+        }
+        doc_.cacheBytes += cache.Bytes() - cacheBytes;
+
+        ImGui::PushID( index_ );
+        ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX;
+        if( ImGui::BeginTable( "##table", cache.columns, flags ) ) {
+            for( int c = 0; c < cache.columns; ++c ) {
+                ImGui::TableSetupColumn( "", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, cache.columnWidths[ c ] );
+            }
+            const int rows = cache.cells.Size / ( cache.columns * 2 );
+            ImGuiListClipper clipper;
+            clipper.Begin( rows );
+            while( clipper.Step() ) {
+                for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row ) {
+                    ImGui::TableNextRow( row == 0 ? ImGuiTableRowFlags_Headers : ImGuiTableRowFlags_None );
+                    if( row == 0 ) {
+                        ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg0, ImGui::GetColorU32( ImGuiCol_TableHeaderBg ) );
+                    }
+                    for( int c = 0; c < cache.columns; ++c ) {
+                        ImGui::TableSetColumnIndex( c );
+                        const int*  cell = &cache.cells[ ( row * cache.columns + c ) * 2 ];
+                        const char* b = base + cell[ 0 ];
+                        const char* e = base + cell[ 1 ];
+                        if( cache.align[ c ] != 'l' ) {
+                            float slack = cache.columnWidths[ c ] - ImGui::CalcTextSize( b, e ).x;
+                            if( slack > 0.0f ) {
+                                ImGui::SetCursorPosX( ImGui::GetCursorPosX() + ( cache.align[ c ] == 'c' ? slack * 0.5f : slack ) );
+                            }
+                        }
+                        ImGui::TextUnformatted( b, e );
+                        HighlightMatches( b, e, mdConfig_ );
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::PopID();
+    }
+
+    void RenderMarkdownDocument( MarkdownDocument& doc_, const MarkdownConfig& mdConfig_ )
+    {
+        // search matches are tinted by the text renderers
+        MarkdownConfig config = mdConfig_;
+        config.highlightBase = doc_.Text();
+        config.highlights = doc_.matches.Data;
+        config.highlightCount = doc_.matches.Size;
+        config.highlightLength = doc_.matchLength;
+        config.currentHighlight = doc_.currentMatch;
+
+        // measured heights depend on wrapping, keep them only as estimates after a resize
+        float width = ImGui::GetContentRegionAvail().x;
+        if( width != doc_.layoutWidth ) {
+            for( int i = 0; i < doc_.blocks.Size; ++i ) {
+                doc_.blocks[ i ].measured = false;
+            }
+            doc_.layoutWidth = width;
+            doc_.layoutDirty = 0;
+        }
+        // after a zoom the heights scale with the font: the blocks keep their relative positions,
+        // so the text under the top of the view stays there, and each block corrects its own
+        // height (wrapping changed too) when it is shown again
+        float fontSize = ImGui::GetFontSize();
+        float zoomScrollY = -1.0f;
+        if( fontSize != doc_.layoutFontSize ) {
+            if( doc_.layoutFontSize > 0.0f ) {
+                const float ratio = fontSize / doc_.layoutFontSize;
+                for( int i = 0; i < doc_.blocks.Size; ++i ) {
+                    doc_.blocks[ i ].height *= ratio;
+                }
+                zoomScrollY = ImGui::GetCursorPosY() + ( ImGui::GetScrollY() - ImGui::GetCursorPosY() ) * ratio;
+            }
+            doc_.layoutFontSize = fontSize;
+            doc_.layoutDirty = 0;
+        }
+        doc_.UpdateLayout( ImGui::GetTextLineHeightWithSpacing() );
+
+        const bool  wasAtBottom = ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 1.0f;
+        const float originY = ImGui::GetCursorPosY();
+        const float viewTop = ImGui::GetScrollY() - originY;
+        const float viewBottom = viewTop + ImGui::GetWindowHeight();
+        if( viewTop != doc_.viewTop && ImGui::IsWindowHovered( ImGuiHoveredFlags_ChildWindows ) ) {
+            doc_.editorSyncLine = doc_.YToLine( viewTop );
+        }
+        doc_.viewTop = viewTop;
+
+        const char* text = doc_.Text();
+        int first = doc_.FindBlockAtY( viewTop );
+        if( first < doc_.blocks.Size ) {
+            ImGui::SetCursorPosY( originY + doc_.blocks[ first ].posY );
+        }
+        for( int i = first; i < doc_.blocks.Size; ++i ) {
+            MarkdownBlock& block = doc_.blocks[ i ];
+            float top = ImGui::GetCursorPosY() - originY;
+            if( top >= viewBottom ) {
+                break;
+            }
+            if( block.type == MarkdownBlockType::CODE ) {
+                RenderCodeBlock( doc_, block, config );
+            }
+            else if( block.type == MarkdownBlockType::TABLE ) {
+                RenderTableBlock( doc_, i, block, config );
+            }
+            else {
+                ImGui::Markdown( text + block.start, (size_t)( block.stop - block.start ), config );
+            }
+            float height = ImGui::GetCursorPosY() - originY - top;
+            if( !block.measured || height != block.height ) {
+                block.height = height;
+                block.measured = true;
+                doc_.layoutDirty = ImMin( doc_.layoutDirty, i + 1 );
+            }
+        }
+
+        // reserve the space of the blocks that were not submitted
+        doc_.UpdateLayout( ImGui::GetTextLineHeightWithSpacing() );
+        ImGui::SetCursorPosY( originY + doc_.totalHeight );
+        ImGui::Dummy( ImVec2( 0.0f, 0.0f ) );
+        if( doc_.scrollToBlock >= 0 && doc_.scrollToBlock < doc_.blocks.Size ) {
+            // positions above the target may still be estimates, which is fine: they are stable
+            // until those blocks are shown, so the target lands at the top of the view
+            ImGui::SetScrollY( originY + doc_.blocks[ doc_.scrollToBlock ].posY );
+        }
+        else if( doc_.previewSyncLine >= 0.0f ) {
+            ImGui::SetScrollY( originY + doc_.LineToY( doc_.previewSyncLine ) );
+        }
+        else if( doc_.autoScroll && wasAtBottom ) {
+            ImGui::SetScrollHereY( 1.0f );
+        }
+        else if( zoomScrollY >= 0.0f ) {
+            ImGui::SetScrollY( zoomScrollY );
+        }
+        doc_.scrollToBlock = -1;
+        doc_.previewSyncLine = -1.0f;
+    }
+
+    void RenderMarkdownOutline( MarkdownDocument& doc_ )
+    {
+        const int current = doc_.FindHeadingAtY( doc_.viewTop + 1.0f );
+        const char* text = doc_.Text();
+        ImGuiListClipper clipper;
+        clipper.Begin( doc_.headings.Size );
+        while( clipper.Step() ) {
+            for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i ) {
+                const MarkdownHeading& heading = doc_.headings[ i ];
+                ImGui::PushID( i );
+                float indent = ( heading.level - 1 ) * ImGui::GetStyle().IndentSpacing;
+                if( indent > 0.0f ) {
+                    ImGui::Indent( indent );
+                }
+                ImVec2 pos = ImGui::GetCursorScreenPos();
+                if( ImGui::Selectable( "##heading", i == current ) ) {
+                    doc_.scrollToBlock = heading.block;
+                }
+                ImGui::GetWindowDrawList()->AddText( pos, ImGui::GetColorU32( ImGuiCol_Text ), text + heading.textStart, text + heading.textStop );
+                if( indent > 0.0f ) {
+                    ImGui::Unindent( indent );
+                }
+                ImGui::PopID();
+            }
+        }
+    }
+}
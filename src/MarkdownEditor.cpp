@@ -0,0 +1,319 @@
+#include "MarkdownEditor.h"
+#include "imgui_internal.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace ImGui
+{
+    static int EditorCallback( ImGuiInputTextCallbackData* data_ )
+    {
+        if( data_->EventFlag == ImGuiInputTextFlags_CallbackResize ) {
+            ImVector<char>* buf = (ImVector<char>*)data_->UserData;
+            IM_ASSERT( buf->begin() == data_->Buf );
+            // called whenever the widget writes its text back: buf is sized to the text, shorter or longer,
+            // so doc_.Length() stays the text length and nothing past the NUL is parsed or saved
+            buf->resize( data_->BufTextLen + 1 );
+            data_->Buf = buf->begin();
+            data_->BufSize = buf->Size;
+        }
+        return 0;
+    }
+
+    static const char* NoClipboard( void* )
+    {
+        return NULL;
+    }
+
+    // Replaces deleteLength_ bytes at pos_ of doc_.buf by the insertLength_ bytes of text_ (wideInsert_ characters
+    // in wide_) and, while the widget is active, the same characters of its own ImWchar copy of the text too, so the
+    // widget does not convert the whole text again. The cursor goes after the inserted text, which is left selected
+    // when select_ is set. Returns the splice.
+    static MarkdownEdit SpliceText( MarkdownDocument& doc_, ImGuiID id_, int pos_, int deleteLength_, const char* text_, int insertLength_,
+        const ImWchar* wide_, int wideInsert_, bool select_ )
+    {
+        ImGuiContext& g = *GImGui;
+        const int oldLength = doc_.Length();
+        const int pos = ImMin( pos_, oldLength );
+        const int deleteLength = ImMin( deleteLength_, oldLength - pos );
+        const int insertLength = insertLength_;
+        char* buf = doc_.buf.Data;
+
+        ImGuiInputTextState* state = g.ActiveId == id_ ? GetInputTextState( id_ ) : NULL;
+        if( state ) {
+            const int widePos = ImTextCountCharsFromUtf8( buf, buf + pos );
+            const int wideDelete = ImTextCountCharsFromUtf8( buf + pos, buf + pos + deleteLength );
+            const int wideInsert = wideInsert_;
+            const int wideLength = state->CurLenW - wideDelete + wideInsert;
+            if( wideLength + 1 > state->TextW.Size ) {
+                state->TextW.resize( wideLength + 1 );
+            }
+            ImWchar* w = state->TextW.Data;
+            memmove( w + widePos + wideInsert, w + widePos + wideDelete, (size_t)( state->CurLenW - widePos - wideDelete + 1 ) * sizeof( ImWchar ) );
+            memcpy( w + widePos, wide_, (size_t)wideInsert * sizeof( ImWchar ) );
+            state->CurLenW = wideLength;
+            state->CurLenA = oldLength - deleteLength + insertLength;
+            state->Stb.cursor = state->Stb.select_start = state->Stb.select_end = widePos + wideInsert;
+            if( select_ ) {
+                state->Stb.select_start = widePos;
+            }
+            state->Stb.has_preferred_x = 0;
+            state->CursorFollow = true;
+            state->CursorAnimReset();
+            state->OffsetW = widePos;           // the widget's next edit is located from here
+            state->OffsetA = pos;
+        }
+
+        const int newLength = oldLength - deleteLength + insertLength;
+        if( newLength + 1 > doc_.buf.Size ) {
+            doc_.buf.resize( newLength + 1 );
+            buf = doc_.buf.Data;
+        }
+        memmove( buf + pos + insertLength, buf + pos + deleteLength, (size_t)( oldLength - pos - deleteLength + 1 ) );
+        memcpy( buf + pos, text_, (size_t)insertLength );
+        doc_.buf.resize( newLength + 1 );
+        return { pos, deleteLength, insertLength };
+    }
+
+    // Narrows the bytes known to be unchanged at the start and at the end of the text to those outside
+    // edit_, just applied to doc_
+    static void KeepUnchanged( const MarkdownDocument& doc_, const MarkdownEdit& edit_, int* sameHead_, int* sameTail_ )
+    {
+        *sameHead_ = ImMin( *sameHead_, edit_.pos );
+        *sameTail_ = ImMin( *sameTail_, doc_.Length() - edit_.pos - edit_.insertLength );
+    }
+
+    // Horizontal scroll the widget draws its text with: its state's ScrollX, on the frames it takes the path that
+    // draws the cursor or the selection (see InputTextEx()), and 0 otherwise
+    static float EditorScrollX( ImGuiWindow* child_, ImGuiID id_ )
+    {
+        ImGuiContext& g = *GImGui;
+        ImGuiInputTextState* state = GetInputTextState( id_ );
+        if( !state ) {
+            return 0.0f;
+        }
+        const bool drawsCursor = g.ActiveId == id_ || g.ActiveId == GetWindowScrollbarID( child_, ImGuiAxis_Y );
+        return drawsCursor || state->HasSelection() ? state->ScrollX : 0.0f;
+    }
+
+    // Draws the visible lines in Markdown colors. The widget draws its own text fully transparent (so
+    // it costs nothing), and this is the only copy on screen: the cost depends on the view, not on the
+    // document. The cursor is drawn in the text color as well, so it is drawn again here, where the
+    // widget reports it for the IME.
+    static void DrawColoredText( MarkdownDocument& doc_, ImGuiWindow* child_, ImGuiID id_ )
+    {
+        ImGuiContext& g = *GImGui;
+        const float lineHeight = g.FontSize;
+        const ImVec2 origin( child_->DC.CursorStartPos.x - EditorScrollX( child_, id_ ), child_->DC.CursorStartPos.y );
+        const int firstLine = ImMax( 0, (int)( child_->Scroll.y / lineHeight ) );
+        const int lastLine = ImMin( doc_.lineStarts.Size, (int)( ( child_->Scroll.y + child_->InnerRect.GetHeight() ) / lineHeight ) + 1 );
+        const float maxX = child_->InnerClipRect.Max.x;
+        const char* text = doc_.Text();
+        static ImVector<SyntaxRun> runs;        // reused from frame to frame
+
+        ImDrawList* drawList = child_->DrawList;
+        drawList->PushClipRect( child_->InnerClipRect.Min, child_->InnerClipRect.Max );
+        for( int line = firstLine; line < lastLine; ++line ) {
+            MarkdownLineState state = doc_.LineState( line );
+            const int lineStop = line + 1 < doc_.lineStarts.Size ? doc_.lineStarts[ line + 1 ] - 1 : doc_.Length();
+            runs.resize( 0 );
+            HighlightMarkdownLine( text, text + doc_.lineStarts[ line ], text + lineStop, &state, runs );
+            ImVec2 pos( origin.x, origin.y + line * lineHeight );
+            for( int i = 0; i < runs.Size && pos.x < maxX; ++i ) {
+                const char* b = text + runs[ i ].start;
+                const char* e = b + runs[ i ].length;
+                drawList->AddText( g.Font, g.FontSize, pos, SyntaxColor( runs[ i ].token ), b, e );
+                pos.x += g.Font->CalcTextSizeA( g.FontSize, FLT_MAX, 0.0f, b, e ).x;
+            }
+        }
+        if( g.ActiveId == id_ && g.PlatformImeData.WantVisible ) {
+            ImGuiInputTextState* state = GetInputTextState( id_ );
+            if( !g.IO.ConfigInputTextCursorBlink || !state || state->CursorAnim <= 0.0f || ImFmod( state->CursorAnim, 1.20f ) <= 0.80f ) {
+                const ImVec2 cursor = g.PlatformImeData.InputPos;
+                drawList->AddLine( ImVec2( cursor.x + 1.0f, cursor.y + 0.5f ), ImVec2( cursor.x + 1.0f, cursor.y + lineHeight - 1.5f ), GetColorU32( ImGuiCol_Text ) );
+            }
+        }
+        drawList->PopClipRect();
+    }
+
+    // Tints the matches on the visible lines. InputTextMultiline lays out one line per FontSize
+    // from the start of its child window, so the line index gives the position of any offset.
+    static void DrawMatches( MarkdownDocument& doc_, ImGuiWindow* child_, ImGuiID id_ )
+    {
+        ImGuiContext& g = *GImGui;
+        const float lineHeight = g.FontSize;
+        const ImVec2 origin( child_->DC.CursorStartPos.x - EditorScrollX( child_, id_ ), child_->DC.CursorStartPos.y );
+        const int firstLine = ImMax( 0, (int)( child_->Scroll.y / lineHeight ) );
+        const int lastLine = ImMin( doc_.lineStarts.Size, (int)( ( child_->Scroll.y + child_->InnerRect.GetHeight() ) / lineHeight ) + 1 );
+        if( firstLine >= lastLine ) {
+            return;
+        }
+        const char* text = doc_.Text();
+        const int   viewStart = doc_.lineStarts[ firstLine ];
+        const int   viewStop = lastLine < doc_.lineStarts.Size ? doc_.lineStarts[ lastLine ] : doc_.Length();
+        const int*  m = std::lower_bound( doc_.matches.begin(), doc_.matches.end(), viewStart );
+
+        ImDrawList* drawList = child_->DrawList;
+        drawList->PushClipRect( child_->InnerClipRect.Min, child_->InnerClipRect.Max );
+        for( ; m < doc_.matches.end() && *m < viewStop; ++m ) {
+            const int line = doc_.FindLineAt( *m );
+            const int lineStart = doc_.lineStarts[ line ];
+            const int lineStop = line + 1 < doc_.lineStarts.Size ? doc_.lineStarts[ line + 1 ] : doc_.Length();
+            const int stop = ImMin( *m + doc_.matchLength, lineStop );
+            float x0 = origin.x + g.Font->CalcTextSizeA( g.FontSize, FLT_MAX, 0.0f, text + lineStart, text + *m ).x;
+            float x1 = x0 + g.Font->CalcTextSizeA( g.FontSize, FLT_MAX, 0.0f, text + *m, text + stop ).x;
+            float y = origin.y + line * lineHeight;
+            bool current = (int)( m - doc_.matches.begin() ) == doc_.currentMatch;
+            drawList->AddRectFilled( ImVec2( x0, y ), ImVec2( x1, y + lineHeight ),
+                GetColorU32( current ? ImGuiCol_PlotHistogram : ImGuiCol_TextSelectedBg, 0.6f ) );
+        }
+        drawList->PopClipRect();
+    }
+
+    MarkdownEdit MarkdownEditor( const char* label_, MarkdownDocument& doc_, UndoHistory* undo_, PasteJob* paste_, const ImVec2& size_, ImGuiInputTextFlags flags_ )
+    {
+        IM_ASSERT( ( flags_ & ( ImGuiInputTextFlags_CallbackResize | ImGuiInputTextFlags_CallbackAlways ) ) == 0 );
+        IM_ASSERT( doc_.trackEdits );
+        ImGuiContext& g = *GImGui;
+        ImGuiWindow* window = GetCurrentWindow();
+        const ImGuiID id = window->GetID( label_ );
+        MarkdownEdit edit;
+        {
+            ProfileTimer timer( PROFILE_INPUTTEXT );
+            // undo / redo come from undo_, the same shortcuts as the widget's own
+            bool redo = false;
+            bool stepped = false;
+            bool pasted = false;
+            bool hideClipboard = false;
+            // bytes at both ends that the paste and the undo / redo step leave as they were
+            int sameHead = INT_MAX;
+            int sameTail = INT_MAX;
+            if( undo_ ) {
+                flags_ |= ImGuiInputTextFlags_NoUndoRedo;
+                const ImGuiIO& io = g.IO;
+                const bool shortcut = io.ConfigMacOSXBehaviors ? io.KeyMods == ImGuiKeyModFlags_Super : io.KeyMods == ImGuiKeyModFlags_Ctrl;
+                const bool editable = g.ActiveId == id && !( flags_ & ImGuiInputTextFlags_ReadOnly );
+                // a large paste is filtered by paste_ on the pool, then spliced in the frame it is done
+                if( paste_ && paste_->IsReady() ) {
+                    const std::string& text = paste_->Text();
+                    const std::vector<ImWchar>& wide = paste_->Wide();
+                    KeepUnchanged( doc_, SpliceText( doc_, id, paste_->pos, paste_->deleteLength, text.data(), (int)text.size(), wide.data(), (int)wide.size(), false ),
+                        &sameHead, &sameTail );
+                    paste_->Finish();
+                    pasted = true;
+                }
+                const bool pasteKey = ( shortcut && IsKeyPressed( ImGuiKey_V ) ) || ( io.KeyMods == ImGuiKeyModFlags_Shift && IsKeyPressed( ImGuiKey_Insert ) );
+                if( paste_ && pasteKey && editable ) {
+                    const char* clipboard = paste_->IsRunning() ? NULL : GetClipboardText();
+                    const size_t length = clipboard ? strlen( clipboard ) : 0;
+                    if( length >= PasteJob::LARGEBYTES ) {
+                        const ImGuiInputTextState* state = GetInputTextState( id );
+                        const ImWchar* text = state->TextW.Data;
+                        const int selectStart = ImMin( state->Stb.select_start, state->Stb.select_end );
+                        const int selectEnd = ImMax( state->Stb.select_start, state->Stb.select_end );
+                        const int from = selectStart != selectEnd ? selectStart : state->Stb.cursor;
+                        const int to = selectStart != selectEnd ? selectEnd : state->Stb.cursor;
+                        const int pos = ImTextCountUtf8BytesFromStr( text, text + from );
+                        paste_->Start( clipboard, length, pos, ImTextCountUtf8BytesFromStr( text + from, text + to ), ( flags_ & ImGuiInputTextFlags_AllowTabInput ) != 0 );
+                    }
+                    // the widget does not paste while a large paste is on its way
+                    hideClipboard = paste_->IsRunning();
+                }
+                const bool shiftShortcut = io.ConfigMacOSXBehaviors && io.KeyMods == ( ImGuiKeyModFlags_Super | ImGuiKeyModFlags_Shift );
+                redo = ( shortcut && IsKeyPressed( ImGuiKey_Y ) ) || ( shiftShortcut && IsKeyPressed( ImGuiKey_Z ) );
+                const bool undo = shortcut && IsKeyPressed( ImGuiKey_Z );
+                // spliced like a paste, so the widget does not convert the whole text again and only the step's range
+                // is committed; the restored text is left selected. Not in the frame a paste lands: that one is recorded.
+                MarkdownEdit step;
+                std::string stepText;
+                if( editable && !pasted && ( ( undo && undo_->GetUndo( &step, stepText ) ) || ( redo && undo_->GetRedo( &step, stepText ) ) ) ) {
+                    ImVector<ImWchar> wide;
+                    wide.resize( step.insertLength + 1 );
+                    const int wideInsert = ImTextStrFromUtf8( wide.Data, wide.Size, stepText.data(), stepText.data() + step.insertLength );
+                    KeepUnchanged( doc_, SpliceText( doc_, id, step.pos, step.deleteLength, stepText.data(), step.insertLength, wide.Data, wideInsert, true ),
+                        &sameHead, &sameTail );
+                    stepped = true;
+                }
+            }
+            const char* ( *getClipboard )( void* ) = g.IO.GetClipboardTextFn;
+            if( hideClipboard ) {
+                g.IO.GetClipboardTextFn = NoClipboard;
+            }
+            PushStyleColor( ImGuiCol_Text, IM_COL32( 0, 0, 0, 0 ) );
+            bool changed = InputTextMultiline( label_, doc_.buf.Data, (size_t)doc_.buf.Size, size_,
+                flags_ | ImGuiInputTextFlags_CallbackResize, EditorCallback, (void*)&doc_.buf );
+            PopStyleColor();
+            g.IO.GetClipboardTextFn = getClipboard;
+            // the line index and the coloring states are brought up to date before drawing
+            if( changed || pasted || stepped ) {
+                // only the bytes between the ends that neither the splices nor the widget touched are compared
+                ImGuiInputTextState* state = GetInputTextState( id );
+                // (a change with no edit recorded is buf no longer matching the widget's text: all of it is compared)
+                if( changed && ( !state || state->UnchangedHeadA == INT_MAX ) ) {
+                    sameHead = sameTail = 0;
+                }
+                else if( changed ) {
+                    sameHead = ImMin( sameHead, state->UnchangedHeadA );
+                    sameTail = ImMin( sameTail, state->UnchangedTailA );
+                }
+                if( state ) {
+                    state->ClearChanged();
+                }
+                ImVector<char> deleted;
+                edit = doc_.CommitEdit( undo_ && !stepped ? &deleted : NULL, sameHead, sameTail );
+                if( stepped && redo ) {
+                    undo_->Redone();
+                }
+                else if( stepped ) {
+                    undo_->Undone();
+                }
+                else if( undo_ ) {
+                    undo_->Record( edit, deleted.Data, doc_.Text() + edit.pos );
+                }
+                if( paste_ ) {
+                    paste_->OnEdit( edit );
+                }
+            }
+        }
+
+        // the text lives in a child window, named as in BeginChildEx()
+        char name[ 256 ];
+        ImFormatString( name, IM_ARRAYSIZE( name ), "%s/%s_%08X", window->Name, label_, id );
+        ImGuiWindow* child = FindWindowByName( name );
+        if( !child || !child->Active ) {
+            return edit;
+        }
+        if( doc_.revealMatch && doc_.currentMatch >= 0 && doc_.currentMatch < doc_.matches.Size ) {
+            float y = doc_.FindLineAt( doc_.matches[ doc_.currentMatch ] ) * GImGui->FontSize;
+            float height = child->InnerRect.GetHeight();
+            if( y < child->Scroll.y || y + GImGui->FontSize > child->Scroll.y + height ) {
+                SetScrollY( child, ImMax( 0.0f, y - height * 0.5f ) );
+            }
+        }
+        doc_.revealMatch = false;
+        // the window under the mouse leads the scroll sync, so the one that follows never echoes it back
+        if( doc_.editorSyncLine >= 0.0f ) {
+            SetScrollY( child, doc_.editorSyncLine * GImGui->FontSize );
+        }
+        else if( child->Scroll.y != doc_.editorScrollY && GImGui->HoveredWindow == child ) {
+            doc_.previewSyncLine = child->Scroll.y / GImGui->FontSize;
+        }
+        doc_.editorSyncLine = -1.0f;
+        doc_.editorScrollY = child->Scroll.y;
+        DrawColoredText( doc_, child, id );
+        if( paste_ && paste_->IsRunning() ) {
+            char progress[ 32 ];
+            ImFormatString( progress, IM_ARRAYSIZE( progress ), "pasting %d%%", (int)( paste_->Progress() * 100.0f ) );
+            const ImVec2 size = CalcTextSize( progress );
+            const ImRect& clip = child->InnerClipRect;
+            child->DrawList->PushClipRect( clip.Min, clip.Max );
+            child->DrawList->AddText( ImVec2( clip.Max.x - size.x - GImGui->Style.FramePadding.x, clip.Min.y + GImGui->Style.FramePadding.y ),
+                GetColorU32( ImGuiCol_TextDisabled ), progress );
+            child->DrawList->PopClipRect();
+        }
+        // the matches are only moved by the search after an edit
+        if( edit.IsEmpty() && doc_.matches.Size > 0 ) {
+            DrawMatches( doc_, child, id );
+        }
+        return edit;
+    }
+}
@@ -0,0 +1,192 @@
+#include "PasteJob.h"
+#include "ThreadPool.h"
+
+#include <string.h>
+
+// Start of the character at or after offset_: a chunk never begins inside a UTF-8 sequence
+static size_t CharBoundary( const std::string& text_, size_t offset_ )
+{
+    for( int i = 0; i < 3 && offset_ < text_.size() && ( (unsigned char)text_[ offset_ ] & 0xc0 ) == 0x80; ++i )
+        ++offset_;
+    return offset_ < text_.size() ? offset_ : text_.size();
+}
+
+// Strict UTF-8 decoding of the next character: overlong forms, surrogates and truncated
+// sequences give U+FFFD for their first byte only. Returns the bytes consumed.
+static int DecodeUtf8( const unsigned char* s_, const unsigned char* end_, unsigned int* c_ )
+{
+    const unsigned int b = s_[ 0 ];
+    if( b < 0x80 )
+    {
+        *c_ = b;
+        return 1;
+    }
+    int length;
+    unsigned int c;
+    unsigned int min;
+    if( ( b & 0xe0 ) == 0xc0 )      { length = 2; c = b & 0x1f; min = 0x80; }
+    else if( ( b & 0xf0 ) == 0xe0 ) { length = 3; c = b & 0x0f; min = 0x800; }
+    else if( ( b & 0xf8 ) == 0xf0 ) { length = 4; c = b & 0x07; min = 0x10000; }
+    else
+    {
+        *c_ = IM_UNICODE_CODEPOINT_INVALID;
+        return 1;
+    }
+    if( end_ - s_ < length )
+    {
+        *c_ = IM_UNICODE_CODEPOINT_INVALID;
+        return 1;
+    }
+    for( int i = 1; i < length; ++i )
+    {
+        if( ( s_[ i ] & 0xc0 ) != 0x80 )
+        {
+            *c_ = IM_UNICODE_CODEPOINT_INVALID;
+            return 1;
+        }
+        c = ( c << 6 ) | ( s_[ i ] & 0x3f );
+    }
+    if( c < min || c > 0x10ffff || ( c >= 0xd800 && c <= 0xdfff ) )
+        c = IM_UNICODE_CODEPOINT_INVALID;
+    *c_ = c;
+    return c == IM_UNICODE_CODEPOINT_INVALID ? 1 : length;
+}
+
+static char* EncodeUtf8( unsigned int c_, char* out_ )
+{
+    if( c_ < 0x80 )
+        *out_++ = (char)c_;
+    else if( c_ < 0x800 )
+    {
+        *out_++ = (char)( 0xc0 | ( c_ >> 6 ) );
+        *out_++ = (char)( 0x80 | ( c_ & 0x3f ) );
+    }
+    else if( c_ < 0x10000 )
+    {
+        *out_++ = (char)( 0xe0 | ( c_ >> 12 ) );
+        *out_++ = (char)( 0x80 | ( ( c_ >> 6 ) & 0x3f ) );
+        *out_++ = (char)( 0x80 | ( c_ & 0x3f ) );
+    }
+    else
+    {
+        *out_++ = (char)( 0xf0 | ( c_ >> 18 ) );
+        *out_++ = (char)( 0x80 | ( ( c_ >> 12 ) & 0x3f ) );
+        *out_++ = (char)( 0x80 | ( ( c_ >> 6 ) & 0x3f ) );
+        *out_++ = (char)( 0x80 | ( c_ & 0x3f ) );
+    }
+    return out_;
+}
+
+// The same characters InputTextMultiline() takes from the clipboard: control characters other
+// than new lines (and tabs when allowed) are dropped, so are code points ImWchar cannot hold
+static void FilterChunk( const char* begin_, const char* end_, bool allowTabs_, std::string& text_, std::vector<ImWchar>& wide_ )
+{
+    // an invalid byte grows to the 3 bytes of U+FFFD, nothing grows more
+    const size_t length = end_ - begin_;
+    text_.resize( length * 3 );
+    wide_.resize( length );
+    char* t = &text_[ 0 ];
+    ImWchar* w = wide_.data();
+    const unsigned char* s = (const unsigned char*)begin_;
+    const unsigned char* end = (const unsigned char*)end_;
+    while( s < end )
+    {
+        // printable ASCII is copied as it is
+        if( *s >= 0x20 && *s < 0x80 )
+        {
+            *t++ = (char)*s;
+            *w++ = (ImWchar)*s++;
+            continue;
+        }
+        unsigned int c;
+        s += DecodeUtf8( s, end, &c );
+        if( c < 0x20 && c != '\n' && !( c == '\t' && allowTabs_ ) )
+            continue;
+        if( c > IM_UNICODE_CODEPOINT_MAX )
+            continue;
+        t = EncodeUtf8( c, t );
+        *w++ = (ImWchar)c;
+    }
+    text_.resize( t - text_.data() );
+    wide_.resize( w - wide_.data() );
+}
+
+void PasteJob::Run( const std::shared_ptr<Work>& work_ )
+{
+    Work& work = *work_;
+    const size_t length = work.source.size();
+    std::vector<std::string> texts( work.chunkCount );
+    std::vector<std::vector<ImWchar>> wides( work.chunkCount );
+    ThreadPool::Shared().ParallelFor( work.chunkCount, 1, [ & ]( int begin_, int end_ )
+    {
+        for( int i = begin_; i < end_ && !work.cancel; ++i )
+        {
+            const size_t from = CharBoundary( work.source, (size_t)i * CHUNKBYTES );
+            const size_t to = i + 1 < work.chunkCount ? CharBoundary( work.source, (size_t)( i + 1 ) * CHUNKBYTES ) : length;
+            FilterChunk( work.source.data() + from, work.source.data() + to, work.allowTabs, texts[ i ], wides[ i ] );
+            ++work.chunksDone;
+        }
+    } );
+    if( work.cancel )
+        return;
+
+    size_t textLength = 0;
+    size_t wideLength = 0;
+    for( int i = 0; i < work.chunkCount; ++i )
+    {
+        textLength += texts[ i ].size();
+        wideLength += wides[ i ].size();
+    }
+    work.text.reserve( textLength );
+    work.wide.reserve( wideLength );
+    for( int i = 0; i < work.chunkCount; ++i )
+    {
+        work.text += texts[ i ];
+        work.wide.insert( work.wide.end(), wides[ i ].begin(), wides[ i ].end() );
+        std::string().swap( texts[ i ] );
+        std::vector<ImWchar>().swap( wides[ i ] );
+    }
+    std::string().swap( work.source );
+    work.done = true;
+}
+
+void PasteJob::Start( const char* text_, size_t length_, int pos_, int deleteLength_, bool allowTabs_ )
+{
+    Cancel();
+    pos = pos_;
+    deleteLength = deleteLength_;
+    work = std::make_shared<Work>();
+    work->source.assign( text_, length_ );
+    work->allowTabs = allowTabs_;
+    work->chunkCount = (int)( ( length_ + CHUNKBYTES - 1 ) / CHUNKBYTES );
+    std::shared_ptr<Work> task = work;
+    ThreadPool::Shared().Submit( [ task ]() { Run( task ); } );
+}
+
+float PasteJob::Progress() const
+{
+    if( !work || work->chunkCount == 0 )
+        return 1.0f;
+    return (float)work->chunksDone / work->chunkCount;
+}
+
+void PasteJob::OnEdit( const ImGui::MarkdownEdit& edit_ )
+{
+    if( !work || edit_.IsEmpty() )
+        return;
+    if( edit_.pos + edit_.deleteLength <= pos )
+        pos += edit_.insertLength - edit_.deleteLength;
+    else if( edit_.pos < pos + deleteLength )
+    {
+        // the replaced range was edited: paste after the edit, replacing nothing
+        pos = edit_.pos + edit_.insertLength;
+        deleteLength = 0;
+    }
+}
+
+void PasteJob::Cancel()
+{
+    if( work )
+        work->cancel = true;
+    work.reset();
+}
@@ -0,0 +1,119 @@
+#include "PngWriter.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static const int STOREDBLOCKBYTES = 65535;  // largest stored deflate block
+
+struct CrcTable {
+    unsigned entries[ 256 ];
+
+    CrcTable() {
+        for( unsigned n = 0; n < 256; ++n )
+        {
+            unsigned c = n;
+            for( int k = 0; k < 8; ++k )
+                c = ( c & 1 ) ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+            entries[ n ] = c;
+        }
+    }
+};
+
+static unsigned Crc32( unsigned crc_, const unsigned char* p_, size_t length_ )
+{
+    static const CrcTable table;    // built once, thread safe
+    crc_ = ~crc_;
+    for( size_t i = 0; i < length_; ++i )
+        crc_ = table.entries[ ( crc_ ^ p_[ i ] ) & 0xFF ] ^ ( crc_ >> 8 );
+    return ~crc_;
+}
+
+static void PutBE32( std::vector<unsigned char>& out_, unsigned value_ )
+{
+    out_.push_back( (unsigned char)( value_ >> 24 ) );
+    out_.push_back( (unsigned char)( value_ >> 16 ) );
+    out_.push_back( (unsigned char)( value_ >> 8 ) );
+    out_.push_back( (unsigned char)value_ );
+}
+
+static bool WriteChunk( FILE* file_, const char* type_, const unsigned char* data_, size_t length_ )
+{
+    std::vector<unsigned char> head;
+    PutBE32( head, (unsigned)length_ );
+    head.insert( head.end(), type_, type_ + 4 );
+    unsigned crc = Crc32( 0, (const unsigned char*)type_, 4 );
+    crc = Crc32( crc, data_, length_ );
+    std::vector<unsigned char> tail;
+    PutBE32( tail, crc );
+    return fwrite( head.data(), 1, head.size(), file_ ) == head.size()
+        && ( length_ == 0 || fwrite( data_, 1, length_, file_ ) == length_ )
+        && fwrite( tail.data(), 1, tail.size(), file_ ) == tail.size();
+}
+
+bool WritePng( const char* path_, const unsigned char* rgba_, int width_, int height_ )
+{
+    if( width_ <= 0 || height_ <= 0 )
+        return false;
+
+    // Filtered scanlines: filter type 0 (none) then the row
+    const size_t rowBytes = (size_t)width_ * 4;
+    std::vector<unsigned char> raw( ( rowBytes + 1 ) * height_ );
+    for( int y = 0; y < height_; ++y )
+    {
+        raw[ y * ( rowBytes + 1 ) ] = 0;
+        memcpy( &raw[ y * ( rowBytes + 1 ) + 1 ], rgba_ + y * rowBytes, rowBytes );
+    }
+
+    // zlib stream: header, stored blocks, Adler-32 of the raw data
+    std::vector<unsigned char> idat;
+    idat.reserve( raw.size() + raw.size() / STOREDBLOCKBYTES * 5 + 16 );
+    idat.push_back( 0x78 );
+    idat.push_back( 0x01 );
+    size_t pos = 0;
+    do
+    {
+        size_t length = raw.size() - pos < (size_t)STOREDBLOCKBYTES ? raw.size() - pos : (size_t)STOREDBLOCKBYTES;
+        bool last = pos + length == raw.size();
+        idat.push_back( last ? 1 : 0 );
+        idat.push_back( (unsigned char)length );
+        idat.push_back( (unsigned char)( length >> 8 ) );
+        idat.push_back( (unsigned char)~length );
+        idat.push_back( (unsigned char)( ~length >> 8 ) );
+        idat.insert( idat.end(), raw.begin() + pos, raw.begin() + pos + length );
+        pos += length;
+    } while( pos < raw.size() );
+    unsigned a = 1, b = 0;
+    for( size_t i = 0; i < raw.size(); )
+    {
+        // 5552 bytes is the most that can be summed before the modulo is needed
+        size_t end = i + 5552 < raw.size() ? i + 5552 : raw.size();
+        for( ; i < end; ++i )
+        {
+            a += raw[ i ];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    PutBE32( idat, ( b << 16 ) | a );
+
+    std::vector<unsigned char> header;
+    PutBE32( header, (unsigned)width_ );
+    PutBE32( header, (unsigned)height_ );
+    header.push_back( 8 );      // bit depth
+    header.push_back( 6 );      // color type: RGBA
+    header.push_back( 0 );      // compression
+    header.push_back( 0 );      // filter
+    header.push_back( 0 );      // interlace
+
+    FILE* file = fopen( path_, "wb" );
+    if( !file )
+        return false;
+    static const unsigned char SIGNATURE[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    bool ok = fwrite( SIGNATURE, 1, sizeof( SIGNATURE ), file ) == sizeof( SIGNATURE )
+        && WriteChunk( file, "IHDR", header.data(), header.size() )
+        && WriteChunk( file, "IDAT", idat.data(), idat.size() )
+        && WriteChunk( file, "IEND", NULL, 0 );
+    return fclose( file ) == 0 && ok;
+}
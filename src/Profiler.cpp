@@ -0,0 +1,309 @@
+#include "Profiler.h"
+#include "imgui.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <algorithm>
+
+std::atomic<bool> Profiler::enabled( false );
+
+static std::atomic<int> Allocations( 0 );
+static std::atomic<int> ThreadCount( 0 );
+static thread_local int ThreadIndex = -1;
+
+static const char* SCOPENAMES[ PROFILE_COUNT + 1 ] = {
+    "Markdown", "RenderLine", "ImageCallback", "LoadTextureFromFile", "InputText", "OpenGL3 RenderDrawData",
+    "LoadFonts", "ThreadPool task", "ParallelFor chunk", "frame"
+};
+
+static int CurrentThread()
+{
+    if( ThreadIndex < 0 )
+        ThreadIndex = ThreadCount++;
+    return ThreadIndex;
+}
+
+static void* CountingAlloc( size_t size_, void* )
+{
+    Allocations.fetch_add( 1, std::memory_order_relaxed );
+    return malloc( size_ );
+}
+
+static void CountingFree( void* ptr_, void* )
+{
+    free( ptr_ );
+}
+
+// p_ in [0, 1] of the count_ values, which are reordered
+static float Percentile( float* values_, int count_, float p_ )
+{
+    if( count_ == 0 )
+        return 0.0f;
+    int k = std::min( count_ - 1, (int)( p_ * count_ ) );
+    std::nth_element( values_, values_ + k, values_ + count_ );
+    return values_[ k ];
+}
+
+Profiler::Profiler() : ring( new Slot[ RINGSIZE ] ), writeIndex( 0 ), readIndex( 0 ), dropped( 0 ), frameCount( 0 ),
+    current(), frameStart( 0 ), allocationsAtStart( 0 ), open( false ), tracing( false ), traceFile( NULL ), traceEvents( 0 ), traceDropped( 0 ),
+    traceStart( 0 ), mainThread( 0 )
+{
+    for( int i = 0; i < RINGSIZE; ++i )
+        ring[ i ].sequence.store( 0, std::memory_order_relaxed );
+}
+
+Profiler& Profiler::Shared()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::InstallAllocator()
+{
+    ImGui::SetAllocatorFunctions( CountingAlloc, CountingFree );
+}
+
+long long Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+void Profiler::Record( int scope_, long long begin_, long long end_ )
+{
+    unsigned long long index = writeIndex.fetch_add( 1, std::memory_order_relaxed );
+    Slot& slot = ring[ index & ( RINGSIZE - 1 ) ];
+    slot.event.begin = begin_;
+    slot.event.end = end_;
+    slot.event.scope = scope_;
+    slot.event.thread = CurrentThread();
+    slot.sequence.store( index + 1, std::memory_order_release );
+}
+
+void Profiler::Drain( Frame& frame_ )
+{
+    const unsigned long long end = writeIndex.load( std::memory_order_acquire );
+    if( end - readIndex > (unsigned long long)RINGSIZE )
+    {
+        // the writers lapped us: the oldest events are gone
+        dropped += end - RINGSIZE - readIndex;
+        readIndex = end - RINGSIZE;
+    }
+    for( ; readIndex < end; ++readIndex )
+    {
+        Slot& slot = ring[ readIndex & ( RINGSIZE - 1 ) ];
+        unsigned long long sequence = slot.sequence.load( std::memory_order_acquire );
+        if( sequence < readIndex + 1 )
+            break;                  // still being written, taken next frame
+        ProfileEvent event = slot.event;
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( sequence != readIndex + 1 || slot.sequence.load( std::memory_order_relaxed ) != sequence )
+        {
+            ++dropped;              // overwritten by a later lap
+            continue;
+        }
+        frame_.scopeMs[ event.scope ] += (float)( event.end - event.begin ) * 1e-6f;
+        ++frame_.calls[ event.scope ];
+        if( tracing && event.begin >= traceStart )
+        {
+            trace.push_back( event );
+            if( (int)trace.size() >= TRACECHUNK )
+                WriteTrace();
+        }
+    }
+}
+
+void Profiler::NewFrame()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    mainThread = CurrentThread();
+    if( ImGui::IsKeyPressed( ImGuiKey_F12, false ) && !io.KeyCtrl && !io.KeyAlt )
+    {
+        if( !io.KeyShift )
+            open = !open;
+        else if( tracing )
+            StopTrace();
+        else
+        {
+            char path[ 64 ];
+            time_t seconds = time( NULL );
+            strftime( path, sizeof( path ), "trace-%Y%m%d-%H%M%S.json", localtime( &seconds ) );
+            if( !StartTrace( path ) )
+                fprintf( stderr, "Cannot write %s\n", path );
+        }
+    }
+
+    long long now = Now();
+    int allocations = Allocations.load( std::memory_order_relaxed );
+    if( enabled && frameStart )
+    {
+        // close the frame that just ended
+        {
+            std::lock_guard<std::mutex> lock( drainLock );
+            Drain( current );
+        }
+        current.frameMs = (float)( now - frameStart ) * 1e-6f;
+        current.allocations = allocations - allocationsAtStart;
+        history[ frameCount % HISTORYFRAMES ] = current;
+        ++frameCount;
+        if( tracing && frameStart >= traceStart )
+            trace.push_back( ProfileEvent{ frameStart, now, PROFILEFRAME, mainThread } );
+    }
+    current = Frame();
+    frameStart = now;
+    allocationsAtStart = allocations;
+    enabled = open || tracing;
+    if( !enabled )
+    {
+        // events of the last recorded frame are discarded
+        readIndex = writeIndex.load( std::memory_order_acquire );
+        frameStart = 0;
+    }
+}
+
+void Profiler::EndFrame( const ImDrawData* drawData_ )
+{
+    if( drawData_ )
+    {
+        current.vertices = drawData_->TotalVtxCount;
+        current.indices = drawData_->TotalIdxCount;
+    }
+}
+
+bool Profiler::StartTrace( const char* path_ )
+{
+    traceFile = fopen( path_, "w" );
+    if( !traceFile )
+        return false;
+    fputs( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", traceFile );
+    tracePath = path_;
+    trace.clear();
+    traceNamed.clear();
+    traceEvents = 0;
+    traceDropped = dropped;
+    traceStart = Now();
+    mainThread = CurrentThread();
+    tracing = true;
+    enabled = true;
+    return true;
+}
+
+bool Profiler::StopTrace()
+{
+    if( !tracing )
+        return false;
+    {
+        std::lock_guard<std::mutex> lock( drainLock );
+        Drain( current );
+    }
+    tracing = false;
+    enabled = open;
+    WriteTrace();
+    fprintf( traceFile, "\n],\"otherData\":{\"droppedEvents\":%llu}}\n", dropped - traceDropped );
+    bool ok = !ferror( traceFile );
+    ok = fclose( traceFile ) == 0 && ok;
+    traceFile = NULL;
+    trace.clear();
+    trace.shrink_to_fit();
+    return ok;
+}
+
+void Profiler::Flush()
+{
+    std::unique_lock<std::mutex> lock( drainLock, std::try_to_lock );
+    if( lock.owns_lock() && tracing )
+        Drain( current );
+}
+
+// Appends the buffered events in Chrome trace-event format: complete ("X") events in microseconds,
+// one track per thread
+void Profiler::WriteTrace()
+{
+    for( const ProfileEvent& event : trace )
+    {
+        if( event.thread >= (int)traceNamed.size() )
+            traceNamed.resize( event.thread + 1, false );
+        if( !traceNamed[ event.thread ] )
+        {
+            traceNamed[ event.thread ] = true;
+            fprintf( traceFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+                traceEvents ? ",\n" : "", event.thread, event.thread == mainThread ? "main" : "thread", event.thread );
+            ++traceEvents;
+        }
+        fprintf( traceFile, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+            traceEvents ? ",\n" : "", SCOPENAMES[ event.scope ], ( event.begin - traceStart ) * 1e-3, ( event.end - event.begin ) * 1e-3, event.thread );
+        ++traceEvents;
+    }
+    trace.clear();
+}
+
+void Profiler::Show()
+{
+    if( !open )
+        return;
+    ImGui::SetNextWindowSize( ImVec2( 520.0f, 0.0f ), ImGuiCond_FirstUseEver );
+    if( !ImGui::Begin( "profiler", &open ) )
+    {
+        ImGui::End();
+        return;
+    }
+
+    const int count = frameCount < HISTORYFRAMES ? frameCount : HISTORYFRAMES;
+    const int first = frameCount - count;
+    float values[ HISTORYFRAMES ];
+    float sorted[ HISTORYFRAMES ];
+    const Frame* last = count ? &history[ ( frameCount - 1 ) % HISTORYFRAMES ] : NULL;
+
+    // frame time, oldest first
+    for( int i = 0; i < count; ++i )
+        values[ i ] = history[ ( first + i ) % HISTORYFRAMES ].frameMs;
+    std::copy( values, values + count, sorted );
+    float p50 = Percentile( sorted, count, 0.5f );
+    float p99 = Percentile( sorted, count, 0.99f );
+    ImGui::Text( "frame  p50 %.2f ms  p99 %.2f ms  (%d frames)", p50, p99, count );
+    ImGui::PlotHistogram( "##frame", values, count, 0, NULL, 0.0f, p99 * 1.25f, ImVec2( -1.0f, 48.0f ) );
+    if( last )
+    {
+        ImGui::Text( "last frame: %d allocations, %d vertices, %d indices", last->allocations, last->vertices, last->indices );
+        for( int i = 0; i < count; ++i )
+            sorted[ i ] = (float)history[ ( first + i ) % HISTORYFRAMES ].allocations;
+        ImGui::Text( "allocations per frame: p50 %.0f  p99 %.0f", Percentile( sorted, count, 0.5f ), Percentile( sorted, count, 0.99f ) );
+    }
+    if( dropped )
+        ImGui::TextDisabled( "%llu events dropped (ring full)", dropped );
+    if( tracing )
+        ImGui::TextColored( ImVec4( 1.0f, 0.4f, 0.4f, 1.0f ), "recording %s (%llu events), Shift+F12 to stop", tracePath.c_str(), traceEvents + trace.size() );
+
+    if( ImGui::BeginTable( "scopes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp ) )
+    {
+        ImGui::TableSetupColumn( "scope" );
+        ImGui::TableSetupColumn( "calls" );
+        ImGui::TableSetupColumn( "p50 ms" );
+        ImGui::TableSetupColumn( "p99 ms" );
+        ImGui::TableSetupColumn( "history", ImGuiTableColumnFlags_WidthStretch, 2.0f );
+        ImGui::TableHeadersRow();
+        for( int scope = 0; scope < PROFILE_COUNT; ++scope )
+        {
+            for( int i = 0; i < count; ++i )
+                values[ i ] = history[ ( first + i ) % HISTORYFRAMES ].scopeMs[ scope ];
+            std::copy( values, values + count, sorted );
+            float scopeP99 = Percentile( sorted, count, 0.99f );
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted( SCOPENAMES[ scope ] );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%d", last ? last->calls[ scope ] : 0 );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", Percentile( sorted, count, 0.5f ) );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", scopeP99 );
+            ImGui::TableNextColumn();
+            ImGui::PushID( scope );
+            ImGui::PlotHistogram( "##history", values, count, 0, NULL, 0.0f, scopeP99 > 0.0f ? scopeP99 * 1.25f : 1.0f, ImVec2( -1.0f, ImGui::GetTextLineHeight() ) );
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
@@ -0,0 +1,318 @@
+#include "QuickOpen.h"
+#include "ThreadPool.h"
+#include "imgui.h"
+
+#include <string.h>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define QUICKOPEN_SSE2
+#endif
+
+static inline unsigned char Fold( unsigned char c_ )
+{
+    return c_ >= 'A' && c_ <= 'Z' ? (unsigned char)( c_ + ( 'a' - 'A' ) ) : c_;
+}
+
+// Bit of the character class of each byte: one per letter and digit, then a few separators
+struct ClassTable
+{
+    unsigned long long bits[ 256 ];
+    ClassTable()
+    {
+        for( int c = 0; c < 256; ++c )
+        {
+            unsigned char f = Fold( (unsigned char)c );
+            if( f >= 'a' && f <= 'z' )
+                bits[ c ] = 1ULL << ( f - 'a' );
+            else if( f >= '0' && f <= '9' )
+                bits[ c ] = 1ULL << ( 26 + f - '0' );
+            else if( f == '/' )
+                bits[ c ] = 1ULL << 36;
+            else if( f == '.' )
+                bits[ c ] = 1ULL << 37;
+            else if( f == '_' )
+                bits[ c ] = 1ULL << 38;
+            else if( f == '-' )
+                bits[ c ] = 1ULL << 39;
+            else if( f == ' ' )
+                bits[ c ] = 1ULL << 40;
+            else
+                bits[ c ] = 1ULL << ( 41 + ( f & 15 ) );
+        }
+    }
+};
+static const ClassTable classTable;
+
+static unsigned long long ClassMask( const char* text_, int length_ )
+{
+    unsigned long long mask = 0;
+    for( int i = 0; i < length_; ++i )
+        mask |= classTable.bits[ (unsigned char)text_[ i ] ];
+    return mask;
+}
+
+// First position in [p_, end_) holding c_ in either case, 16 bytes per compare
+static const char* FindFolded( const char* p_, const char* end_, unsigned char c_ )
+{
+    const unsigned char lower = Fold( c_ );
+    const unsigned char upper = lower >= 'a' && lower <= 'z' ? (unsigned char)( lower - ( 'a' - 'A' ) ) : lower;
+#ifdef QUICKOPEN_SSE2
+    const __m128i lo = _mm_set1_epi8( (char)lower );
+    const __m128i hi = _mm_set1_epi8( (char)upper );
+    for( ; end_ - p_ >= 16; p_ += 16 )
+    {
+        __m128i block = _mm_loadu_si128( (const __m128i*)p_ );
+        int mask = _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( block, lo ), _mm_cmpeq_epi8( block, hi ) ) );
+        if( mask )
+            return p_ + __builtin_ctz( (unsigned)mask );
+    }
+#endif
+    for( ; p_ < end_; ++p_ )
+    {
+        if( (unsigned char)*p_ == lower || (unsigned char)*p_ == upper )
+            return p_;
+    }
+    return nullptr;
+}
+
+static inline bool IsBoundary( char c_ )
+{
+    return c_ == '/' || c_ == '_' || c_ == '-' || c_ == '.' || c_ == ' ';
+}
+
+int FuzzyScore( const char* query_, int queryLength_, const char* text_, int textLength_ )
+{
+    if( queryLength_ == 0 )
+        return 0;
+    const char* end = text_ + textLength_;
+
+    // leftmost match of the whole query gives the end of the window...
+    const char* p = text_;
+    for( int q = 0; q < queryLength_; ++q, ++p )
+    {
+        p = FindFolded( p, end, (unsigned char)query_[ q ] );
+        if( !p )
+            return FUZZYNOMATCH;
+    }
+    const int stop = (int)( p - text_ ) - 1;
+    // ...and matching backwards from there gives the shortest window ending at it
+    int start = stop;
+    for( int q = queryLength_ - 1; start >= 0; --start )
+    {
+        if( Fold( (unsigned char)text_[ start ] ) == Fold( (unsigned char)query_[ q ] ) && --q < 0 )
+            break;
+    }
+
+    // score the greedy match inside the window, jumping from one matched character to the next
+    int score = 0;
+    int previous = start - 1;
+    bool inName = false;                            // past the last '/'
+    for( int q = 0; q < queryLength_; ++q )
+    {
+        const int t = (int)( FindFolded( text_ + previous + 1, end, (unsigned char)query_[ q ] ) - text_ );
+        int bonus = 16;
+        if( t == 0 || text_[ t - 1 ] == '/' )
+            bonus += 12;
+        else if( IsBoundary( text_[ t - 1 ] ) )
+            bonus += 10;
+        else if( text_[ t - 1 ] >= 'a' && text_[ t - 1 ] <= 'z' && text_[ t ] >= 'A' && text_[ t ] <= 'Z' )
+            bonus += 8;                                 // camelCase hump
+        if( q > 0 && previous == t - 1 )
+            bonus += 6;
+        if( !inName )
+            inName = !memchr( text_ + t, '/', (size_t)( end - text_ - t ) );
+        if( inName )
+            bonus += 4;                                 // in the file name rather than the folders
+        score += bonus - ( q > 0 ? t - previous - 1 : 0 );  // gaps inside the window cost
+        previous = t;
+    }
+    return score - ( textLength_ >> 3 );                // shorter paths win ties
+}
+
+// Min-heap on score (then on later index), so the front is the first result to drop
+static inline bool WorseFirst( const QuickOpen::Result& a_, const QuickOpen::Result& b_ )
+{
+    return a_.score != b_.score ? a_.score > b_.score : a_.index < b_.index;
+}
+
+void QuickOpen::SetCandidates( std::vector<const char*> paths_, std::vector<int> lengths_ )
+{
+    paths = std::move( paths_ );
+    lengths = std::move( lengths_ );
+    masks.resize( paths.size() );
+    auto body = [ this ]( int begin_, int end_ )
+    {
+        for( int i = begin_; i < end_; ++i )
+            masks[ i ] = ClassMask( paths[ i ], lengths[ i ] );
+    };
+    if( (int)paths.size() >= PARALLELMIN )
+        ThreadPool::Shared().ParallelFor( (int)paths.size(), GRAIN, body );
+    else
+        body( 0, (int)paths.size() );
+    survivors.clear();
+    haveSurvivors = false;
+}
+
+void QuickOpen::Search( const char* query_ )
+{
+    const int queryLength = (int)strlen( query_ );
+    results.clear();
+    if( queryLength == 0 )
+    {
+        for( int i = 0; i < (int)paths.size() && i < TOPK; ++i )
+            results.push_back( { 0, i } );
+        haveSurvivors = false;
+        return;
+    }
+
+    // a query that extends the last one can only match a subset of its survivors
+    bool refine = haveSurvivors && survivorQuery.size() <= (size_t)queryLength;
+    for( size_t i = 0; refine && i < survivorQuery.size(); ++i )
+        refine = Fold( (unsigned char)survivorQuery[ i ] ) == Fold( (unsigned char)query_[ i ] );
+    const int count = refine ? (int)survivors.size() : (int)paths.size();
+    const unsigned long long queryMask = ClassMask( query_, queryLength );
+
+    const int chunks = count >= PARALLELMIN ? ( count + GRAIN - 1 ) / GRAIN : 1;
+    std::vector<std::vector<int>> kept( chunks );
+    std::vector<std::vector<Result>> heaps( chunks );
+    auto body = [ & ]( int begin_, int end_ )
+    {
+        const int chunk = chunks > 1 ? begin_ / GRAIN : 0;
+        std::vector<int>& keep = kept[ chunk ];
+        std::vector<Result>& heap = heaps[ chunk ];
+        for( int i = begin_; i < end_; ++i )
+        {
+            const int index = refine ? survivors[ i ] : i;
+            if( ( masks[ index ] & queryMask ) != queryMask )
+                continue;
+            const int score = FuzzyScore( query_, queryLength, paths[ index ], lengths[ index ] );
+            if( score == FUZZYNOMATCH )
+                continue;
+            keep.push_back( index );
+            Result result = { score, index };
+            if( (int)heap.size() < TOPK )
+            {
+                heap.push_back( result );
+                std::push_heap( heap.begin(), heap.end(), WorseFirst );
+            }
+            else if( WorseFirst( result, heap.front() ) )
+            {
+                std::pop_heap( heap.begin(), heap.end(), WorseFirst );
+                heap.back() = result;
+                std::push_heap( heap.begin(), heap.end(), WorseFirst );
+            }
+        }
+    };
+    if( chunks > 1 )
+        ThreadPool::Shared().ParallelFor( count, GRAIN, body );
+    else
+        body( 0, count );
+
+    std::vector<int> next;
+    for( const std::vector<int>& keep : kept )
+        next.insert( next.end(), keep.begin(), keep.end() );
+    survivors.swap( next );
+    survivorQuery.assign( query_, (size_t)queryLength );
+    haveSurvivors = true;
+    for( const std::vector<Result>& heap : heaps )
+        results.insert( results.end(), heap.begin(), heap.end() );
+    std::sort( results.begin(), results.end(), WorseFirst );
+    if( (int)results.size() > TOPK )
+        results.resize( TOPK );
+}
+
+int QuickOpen::InputCallback( ImGuiInputTextCallbackData* data_ )
+{
+    QuickOpen* self = (QuickOpen*)data_->UserData;
+    if( data_->EventFlag == ImGuiInputTextFlags_CallbackHistory )
+    {
+        if( data_->EventKey == ImGuiKey_UpArrow && self->selected > 0 )
+            --self->selected;
+        else if( data_->EventKey == ImGuiKey_DownArrow && self->selected + 1 < (int)self->results.size() )
+            ++self->selected;
+        self->scrollToSelected = true;
+    }
+    return 0;
+}
+
+std::string QuickOpen::Show( WorkspaceIndex& workspace_ )
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if( io.KeyCtrl && ImGui::IsKeyPressed( ImGuiKey_P ) )
+    {
+        open = true;
+        focus = true;
+    }
+    if( !open )
+        return std::string();
+
+    bool rerun = false;
+    if( workspace_.Version() != entriesVersion )
+    {
+        entriesVersion = workspace_.Version();
+        entries = workspace_.Entries();
+        std::vector<const char*> candidatePaths;
+        std::vector<int> candidateLengths;
+        candidatePaths.reserve( entries->size() );
+        candidateLengths.reserve( entries->size() );
+        for( const WorkspaceEntry& entry : *entries )
+        {
+            candidatePaths.push_back( entry.path.c_str() );
+            candidateLengths.push_back( (int)entry.path.size() );
+        }
+        SetCandidates( std::move( candidatePaths ), std::move( candidateLengths ) );
+        rerun = true;
+    }
+
+    std::string chosen;
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos( ImVec2( viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + viewport->WorkSize.y * 0.15f ), ImGuiCond_Appearing, ImVec2( 0.5f, 0.0f ) );
+    ImGui::SetNextWindowSize( ImVec2( viewport->WorkSize.x * 0.5f, viewport->WorkSize.y * 0.5f ), ImGuiCond_Appearing );
+    if( focus )
+        ImGui::SetNextWindowFocus();
+    ImGui::Begin( "quick open", &open, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking );
+    if( focus )
+    {
+        ImGui::SetKeyboardFocusHere();
+        focus = false;
+    }
+    ImGui::SetNextItemWidth( -FLT_MIN );
+    bool enter = ImGui::InputText( "##quickopen", query, IM_ARRAYSIZE( query ),
+        ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CallbackHistory, InputCallback, this );
+    if( rerun || lastQuery != query )
+    {
+        lastQuery = query;
+        Search( query );
+        selected = 0;
+        scrollToSelected = true;
+    }
+
+    const ImVec4 dim = ImGui::GetStyle().Colors[ ImGuiCol_TextDisabled ];
+    ImGui::BeginChild( "results" );
+    for( int i = 0; i < (int)results.size(); ++i )
+    {
+        const WorkspaceEntry& entry = ( *entries )[ results[ i ].index ];
+        ImGui::PushID( i );
+        if( ImGui::Selectable( entry.path.c_str(), i == selected ) )
+            chosen = workspace_.Root() + "/" + entry.path;
+        if( i == selected && scrollToSelected )
+        {
+            ImGui::SetScrollHereY();
+            scrollToSelected = false;
+        }
+        if( !entry.title.empty() )
+        {
+            ImGui::SameLine();
+            ImGui::TextColored( dim, "%s", entry.title.c_str() );
+        }
+        ImGui::PopID();
+    }
+    ImGui::EndChild();
+    if( enter && selected < (int)results.size() )
+        chosen = workspace_.Root() + "/" + ( *entries )[ results[ selected ].index ].path;
+    if( ImGui::IsKeyPressed( ImGuiKey_Escape ) || !chosen.empty() )
+        open = false;
+    ImGui::End();
+    return chosen;
+}
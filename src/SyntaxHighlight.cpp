@@ -0,0 +1,222 @@
+#include "SyntaxHighlight.h"
+#include "imgui_internal.h"
+#include <string.h>
+
+static const char* const CppKeywords[] = {
+    "alignas", "alignof", "auto", "bool", "break", "case", "catch", "char", "class", "const", "constexpr",
+    "continue", "decltype", "default", "delete", "do", "double", "else", "enum", "explicit", "extern", "false",
+    "float", "for", "friend", "goto", "if", "inline", "int", "long", "namespace", "new", "noexcept", "nullptr",
+    "operator", "private", "protected", "public", "return", "short", "signed", "sizeof", "static", "struct",
+    "switch", "template", "this", "throw", "true", "try", "typedef", "typename", "union", "unsigned", "using",
+    "virtual", "void", "volatile", "while", NULL };
+
+static const char* const PythonKeywords[] = {
+    "False", "None", "True", "and", "as", "assert", "async", "await", "break", "class", "continue", "def", "del",
+    "elif", "else", "except", "finally", "for", "from", "global", "if", "import", "in", "is", "lambda",
+    "nonlocal", "not", "or", "pass", "raise", "return", "self", "try", "while", "with", "yield", NULL };
+
+static const char* const JsKeywords[] = {
+    "async", "await", "break", "case", "catch", "class", "const", "continue", "default", "delete", "do", "else",
+    "export", "extends", "false", "finally", "for", "from", "function", "if", "import", "in", "instanceof",
+    "interface", "let", "new", "null", "of", "return", "static", "super", "switch", "this", "throw", "true",
+    "try", "type", "typeof", "undefined", "var", "void", "while", "yield", NULL };
+
+static const char* const RustKeywords[] = {
+    "as", "async", "await", "break", "const", "continue", "crate", "dyn", "else", "enum", "false", "fn", "for",
+    "if", "impl", "in", "let", "loop", "match", "mod", "move", "mut", "pub", "ref", "return", "self", "Self",
+    "static", "struct", "super", "trait", "true", "type", "unsafe", "use", "where", "while", NULL };
+
+static const char* const GoKeywords[] = {
+    "break", "case", "chan", "const", "continue", "default", "defer", "else", "fallthrough", "false", "for",
+    "func", "go", "goto", "if", "import", "interface", "map", "nil", "package", "range", "return", "select",
+    "struct", "switch", "true", "type", "var", NULL };
+
+static const char* const JavaKeywords[] = {
+    "abstract", "boolean", "break", "byte", "case", "catch", "char", "class", "continue", "default", "do",
+    "double", "else", "enum", "extends", "false", "final", "finally", "float", "for", "if", "implements",
+    "import", "instanceof", "int", "interface", "long", "new", "null", "package", "private", "protected",
+    "public", "return", "short", "static", "super", "switch", "this", "throw", "throws", "true", "try", "var",
+    "void", "while", NULL };
+
+static const char* const ShellKeywords[] = {
+    "case", "do", "done", "elif", "else", "esac", "export", "fi", "for", "function", "if", "in", "local",
+    "return", "then", "until", "while", NULL };
+
+static const char* const LuaKeywords[] = {
+    "and", "break", "do", "else", "elseif", "end", "false", "for", "function", "if", "in", "local", "nil",
+    "not", "or", "repeat", "return", "then", "true", "until", "while", NULL };
+
+static const char* const JsonKeywords[] = { "true", "false", "null", NULL };
+
+static const SyntaxLanguage Languages[] = {
+    { "c cpp c++ cc cxx h hpp glsl hlsl",   CppKeywords,    "//",   "/*",       "*/",       "\"'",  '#' },
+    { "python py",                          PythonKeywords, "#",    "\"\"\"",   "\"\"\"",   "\"'",  0   },
+    { "javascript js jsx typescript ts tsx",JsKeywords,     "//",   "/*",       "*/",       "\"'`", 0   },
+    { "rust rs",                            RustKeywords,   "//",   "/*",       "*/",       "\"",   0   },
+    { "go golang",                          GoKeywords,     "//",   "/*",       "*/",       "\"'`", 0   },
+    { "java kotlin kt cs csharp",           JavaKeywords,   "//",   "/*",       "*/",       "\"'",  0   },
+    { "sh bash shell zsh console",          ShellKeywords,  "#",    NULL,       NULL,       "\"'",  0   },
+    { "lua",                                LuaKeywords,    "--",   "--[[",     "]]",       "\"'",  0   },
+    { "json",                               JsonKeywords,   NULL,   NULL,       NULL,       "\"",   0   },
+};
+
+const SyntaxLanguage* FindSyntaxLanguage( const char* name_, const char* nameEnd_ )
+{
+    int length = (int)( nameEnd_ - name_ );
+    if( length <= 0 )
+        return NULL;
+    for( int i = 0; i < IM_ARRAYSIZE( Languages ); ++i )
+    {
+        for( const char* n = Languages[ i ].names; *n; )
+        {
+            const char* end = strchr( n, ' ' );
+            if( !end )
+                end = n + strlen( n );
+            if( end - n == length && ImStrnicmp( n, name_, (size_t)length ) == 0 )
+                return &Languages[ i ];
+            n = *end ? end + 1 : end;
+        }
+    }
+    return NULL;
+}
+
+static bool IsIdentChar( char c_ )
+{
+    return ( c_ >= 'a' && c_ <= 'z' ) || ( c_ >= 'A' && c_ <= 'Z' ) || ( c_ >= '0' && c_ <= '9' ) || c_ == '_' || ( c_ & 0x80 );
+}
+
+static bool StartsWith( const char* p_, const char* end_, const char* s_ )
+{
+    size_t n = strlen( s_ );
+    return (size_t)( end_ - p_ ) >= n && memcmp( p_, s_, n ) == 0;
+}
+
+static bool IsKeyword( const SyntaxLanguage* lang_, const char* word_, int length_ )
+{
+    for( const char* const* k = lang_->keywords; *k; ++k )
+    {
+        if( (*k)[ 0 ] == word_[ 0 ] && (int)strlen( *k ) == length_ && memcmp( *k, word_, (size_t)length_ ) == 0 )
+            return true;
+    }
+    return false;
+}
+
+void AddSyntaxRun( ImVector<SyntaxRun>& runs_, int start_, int length_, SyntaxToken token_ )
+{
+    if( length_ <= 0 )
+        return;
+    if( !runs_.empty() && runs_.back().token == token_ && runs_.back().start + runs_.back().length == start_ )
+    {
+        runs_.back().length += length_;
+        return;
+    }
+    SyntaxRun run = { start_, length_, token_ };
+    runs_.push_back( run );
+}
+
+void HighlightLine( const SyntaxLanguage* lang_, const char* base_, const char* line_, const char* lineEnd_, int* state_, ImVector<SyntaxRun>& runs_ )
+{
+    const char* p = line_;
+    if( !lang_ )
+    {
+        AddSyntaxRun( runs_, (int)( p - base_ ), (int)( lineEnd_ - p ), SYNTAX_TEXT );
+        return;
+    }
+
+    if( *state_ == 1 )                  // inside a block comment started on a previous line
+    {
+        const char* close = NULL;
+        for( const char* q = p; q < lineEnd_ && !close; ++q )
+        {
+            if( StartsWith( q, lineEnd_, lang_->blockCommentClose ) )
+                close = q + strlen( lang_->blockCommentClose );
+        }
+        const char* end = close ? close : lineEnd_;
+        AddSyntaxRun( runs_, (int)( p - base_ ), (int)( end - p ), SYNTAX_COMMENT );
+        if( !close )
+            return;
+        *state_ = 0;
+        p = end;
+    }
+
+    const char* first = p;
+    while( first < lineEnd_ && ( *first == ' ' || *first == '\t' ) ) { ++first; }
+    if( lang_->preprocessor && first < lineEnd_ && *first == lang_->preprocessor )
+    {
+        AddSyntaxRun( runs_, (int)( p - base_ ), (int)( lineEnd_ - p ), SYNTAX_PREPROCESSOR );
+        return;
+    }
+
+    while( p < lineEnd_ )
+    {
+        const char* start = p;
+        char c = *p;
+        if( lang_->blockCommentOpen && StartsWith( p, lineEnd_, lang_->blockCommentOpen ) )
+        {
+            p += strlen( lang_->blockCommentOpen );
+            *state_ = 1;
+            while( p < lineEnd_ )
+            {
+                if( StartsWith( p, lineEnd_, lang_->blockCommentClose ) )
+                {
+                    p += strlen( lang_->blockCommentClose );
+                    *state_ = 0;
+                    break;
+                }
+                ++p;
+            }
+            AddSyntaxRun( runs_, (int)( start - base_ ), (int)( p - start ), SYNTAX_COMMENT );
+        }
+        else if( lang_->lineComment && StartsWith( p, lineEnd_, lang_->lineComment ) )
+        {
+            AddSyntaxRun( runs_, (int)( start - base_ ), (int)( lineEnd_ - start ), SYNTAX_COMMENT );
+            p = lineEnd_;
+        }
+        else if( strchr( lang_->stringDelimiters, c ) && c != 0 )
+        {
+            ++p;
+            while( p < lineEnd_ && *p != c )
+            {
+                if( *p == '\\' && p + 1 < lineEnd_ )
+                    ++p;
+                ++p;
+            }
+            if( p < lineEnd_ )
+                ++p;
+            AddSyntaxRun( runs_, (int)( start - base_ ), (int)( p - start ), SYNTAX_STRING );
+        }
+        else if( c >= '0' && c <= '9' )
+        {
+            while( p < lineEnd_ && ( IsIdentChar( *p ) || *p == '.' ) ) { ++p; }
+            AddSyntaxRun( runs_, (int)( start - base_ ), (int)( p - start ), SYNTAX_NUMBER );
+        }
+        else if( IsIdentChar( c ) )
+        {
+            while( p < lineEnd_ && IsIdentChar( *p ) ) { ++p; }
+            bool keyword = IsKeyword( lang_, start, (int)( p - start ) );
+            AddSyntaxRun( runs_, (int)( start - base_ ), (int)( p - start ), keyword ? SYNTAX_KEYWORD : SYNTAX_TEXT );
+        }
+        else
+        {
+            ++p;
+            AddSyntaxRun( runs_, (int)( start - base_ ), 1, SYNTAX_TEXT );
+        }
+    }
+}
+
+ImU32 SyntaxColor( SyntaxToken token_ )
+{
+    switch( token_ )
+    {
+    case SYNTAX_KEYWORD:        return IM_COL32( 86, 156, 214, 255 );
+    case SYNTAX_STRING:         return IM_COL32( 206, 145, 120, 255 );
+    case SYNTAX_NUMBER:         return IM_COL32( 181, 206, 168, 255 );
+    case SYNTAX_COMMENT:        return IM_COL32( 106, 153, 85, 255 );
+    case SYNTAX_PREPROCESSOR:   return IM_COL32( 197, 134, 192, 255 );
+    case SYNTAX_HEADING:        return IM_COL32( 78, 201, 176, 255 );
+    case SYNTAX_EMPHASIS:       return IM_COL32( 220, 220, 170, 255 );
+    case SYNTAX_LINK:           return IM_COL32( 79, 193, 255, 255 );
+    case SYNTAX_CODE:           return IM_COL32( 214, 157, 133, 255 );
+    default:                    return ImGui::GetColorU32( ImGuiCol_Text );
+    }
+}
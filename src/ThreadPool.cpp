@@ -0,0 +1,137 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+#include <memory>
+#include <algorithm>
+
+static thread_local ThreadPool* CurrentPool = nullptr;
+static thread_local int         CurrentWorker = -1;
+
+ThreadPool::ThreadPool( int threads_ ) : queues( threads_ > 0 ? threads_ : ( std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 2 ) ),
+    pending( 0 ), next( 0 ), stop( false )
+{
+    for( size_t i = 0; i < queues.size(); ++i )
+        workers.emplace_back( &ThreadPool::WorkerMain, this, (int)i );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        stop = true;
+    }
+    wake.notify_all();
+    for( std::thread& worker : workers )
+        worker.join();
+}
+
+ThreadPool& ThreadPool::Shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::Submit( std::function<void()> task_ )
+{
+    int index = CurrentPool == this ? CurrentWorker : (int)( next++ % queues.size() );
+    {
+        std::lock_guard<std::mutex> lock( queues[ index ].mutex );
+        queues[ index ].tasks.push_back( std::move( task_ ) );
+    }
+    {
+        // taken so a worker cannot miss the wake up between its last look and its wait
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        ++pending;
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::ParallelFor( int count_, int grain_, const std::function<void( int, int )>& body_ )
+{
+    struct State {
+        std::atomic<int>        next{ 0 };
+        std::atomic<int>        done{ 0 };
+        int                     chunks = 0;
+        std::mutex              mutex;
+        std::condition_variable finished;
+    };
+    if( grain_ < 1 )
+        grain_ = 1;
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->chunks = ( count_ + grain_ - 1 ) / grain_;
+    // helpers outlive this call when they start after the last chunk was taken, so they hold
+    // the state but only touch body_ for a chunk they claimed
+    const std::function<void( int, int )>* body = &body_;
+    auto run = [ state, body, count_, grain_ ]()
+    {
+        for( int chunk; ( chunk = state->next++ ) < state->chunks; )
+        {
+            int begin = chunk * grain_;
+            {
+                ProfileTimer timer( PROFILE_CHUNK );
+                ( *body )( begin, begin + grain_ < count_ ? begin + grain_ : count_ );
+            }
+            if( ++state->done == state->chunks )
+            {
+                std::lock_guard<std::mutex> lock( state->mutex );
+                state->finished.notify_all();
+            }
+        }
+    };
+    int helpers = std::min( state->chunks - 1, Size() );
+    for( int i = 0; i < helpers; ++i )
+        Submit( run );
+    run();
+    std::unique_lock<std::mutex> lock( state->mutex );
+    state->finished.wait( lock, [ &state ] { return state->done == state->chunks; } );
+}
+
+bool ThreadPool::Pop( int index_, std::function<void()>& task_ )
+{
+    {
+        Queue& own = queues[ index_ ];
+        std::lock_guard<std::mutex> lock( own.mutex );
+        if( !own.tasks.empty() )
+        {
+            task_ = std::move( own.tasks.back() );
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for( size_t i = 1; i < queues.size(); ++i )
+    {
+        Queue& victim = queues[ ( index_ + i ) % queues.size() ];
+        std::lock_guard<std::mutex> lock( victim.mutex );
+        if( !victim.tasks.empty() )
+        {
+            task_ = std::move( victim.tasks.front() );
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::WorkerMain( int index_ )
+{
+    CurrentPool = this;
+    CurrentWorker = index_;
+    std::function<void()> task;
+    for( ;; )
+    {
+        if( Pop( index_, task ) )
+        {
+            --pending;
+            {
+                ProfileTimer timer( PROFILE_TASK );
+                task();
+            }
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock( sleepMutex );
+        wake.wait( lock, [ this ] { return stop || pending > 0; } );
+        if( stop )
+            return;
+    }
+}
@@ -0,0 +1,166 @@
+#include "TrigramIndex.h"
+
+#include <string.h>
+#include <iterator>
+
+static inline unsigned char Fold( unsigned char c_ )
+{
+    return c_ >= 'A' && c_ <= 'Z' ? (unsigned char)( c_ + ( 'a' - 'A' ) ) : c_;
+}
+
+// Bitmap position of the trigram at p_, hashed down to 16 bits
+static inline unsigned int TrigramBit( const char* p_ )
+{
+    unsigned int key = Fold( (unsigned char)p_[ 0 ] ) | ( Fold( (unsigned char)p_[ 1 ] ) << 8 ) | ( Fold( (unsigned char)p_[ 2 ] ) << 16 );
+    return ( key * 2654435761u ) >> 16;
+}
+
+static bool MatchAt( const char* text_, const char* query_, int queryLength_, bool caseSensitive_ )
+{
+    if( caseSensitive_ )
+        return memcmp( text_, query_, (size_t)queryLength_ ) == 0;
+    for( int i = 0; i < queryLength_; ++i )
+    {
+        if( Fold( (unsigned char)text_[ i ] ) != Fold( (unsigned char)query_[ i ] ) )
+            return false;
+    }
+    return true;
+}
+
+void TrigramIndex::Build( const char* text_, int length_ )
+{
+    chunks.clear();
+    for( int pos = 0; pos < length_; pos += CHUNKSIZE )
+    {
+        chunks.push_back( Chunk() );
+        chunks.back().length = length_ - pos < CHUNKSIZE ? length_ - pos : CHUNKSIZE;
+        IndexChunk( chunks.back(), text_, pos, length_ );
+    }
+    built = true;
+}
+
+void TrigramIndex::Clear()
+{
+    std::vector<Chunk>().swap( chunks );
+    built = false;
+}
+
+void TrigramIndex::IndexChunk( Chunk& chunk_, const char* text_, int start_, int length_ )
+{
+    static_assert( BITMAPBITS == 1 << 16, "TrigramBit() yields 16 bits" );
+    chunk_.bits.assign( BITMAPBITS / 64, 0 );
+    int end = start_ + chunk_.length + OVERLAP;
+    if( end > length_ )
+        end = length_;
+    for( int p = start_; p + 3 <= end; ++p )
+    {
+        unsigned int bit = TrigramBit( text_ + p );
+        chunk_.bits[ bit >> 6 ] |= 1ULL << ( bit & 63 );
+    }
+}
+
+void TrigramIndex::Update( const ImGui::MarkdownEdit& edit_, const char* text_, int length_ )
+{
+    if( !built || edit_.IsEmpty() )
+        return;
+    if( chunks.empty() )
+    {
+        Build( text_, length_ );
+        return;
+    }
+
+    // chunks holding the start and the end of the replaced bytes (old offsets)
+    const int count = (int)chunks.size();
+    int first = 0, firstStart = 0;
+    while( first + 1 < count && firstStart + chunks[ first ].length <= edit_.pos )
+    {
+        firstStart += chunks[ first ].length;
+        ++first;
+    }
+    int last = first, lastStop = firstStart + chunks[ first ].length;
+    while( last + 1 < count && lastStop < edit_.pos + edit_.deleteLength )
+    {
+        ++last;
+        lastStop += chunks[ last ].length;
+    }
+    int rangeLength = lastStop + edit_.insertLength - edit_.deleteLength - firstStart;
+    // a short leftover is merged with the next chunk so edits do not leave slivers behind
+    if( rangeLength < CHUNKSIZE / 2 && last + 1 < count )
+    {
+        ++last;
+        rangeLength += chunks[ last ].length;
+    }
+
+    // cut the range again into even pieces
+    std::vector<Chunk> fresh;
+    int pieces = ( rangeLength + CHUNKSIZE - 1 ) / CHUNKSIZE;
+    int pos = firstStart;
+    for( int i = 0; i < pieces; ++i )
+    {
+        fresh.push_back( Chunk() );
+        fresh.back().length = rangeLength / pieces + ( i < rangeLength % pieces ? 1 : 0 );
+        IndexChunk( fresh.back(), text_, pos, length_ );
+        pos += fresh.back().length;
+    }
+    chunks.erase( chunks.begin() + first, chunks.begin() + last + 1 );
+    chunks.insert( chunks.begin() + first, std::make_move_iterator( fresh.begin() ), std::make_move_iterator( fresh.end() ) );
+
+    // chunks before the range also index the first bytes of it
+    int start = firstStart;
+    for( int i = first - 1; i >= 0 && start + OVERLAP > firstStart; --i )
+    {
+        start -= chunks[ i ].length;
+        IndexChunk( chunks[ i ], text_, start, length_ );
+    }
+}
+
+void TrigramIndex::Find( const char* text_, int length_, const char* query_, int queryLength_, bool caseSensitive_,
+    ImVector<int>& matches_, int maxMatches_ ) const
+{
+    matches_.resize( 0 );
+    if( queryLength_ <= 0 )
+        return;
+
+    // queries shorter than a trigram have no filter: every chunk is scanned
+    unsigned int filter[ OVERLAP ];
+    int filterCount = 0;
+    for( int j = 0; j + 3 <= queryLength_ && j < OVERLAP; ++j )
+        filter[ filterCount++ ] = TrigramBit( query_ + j );
+
+    const unsigned char first = (unsigned char)query_[ 0 ];
+    const bool firstIsLetter = Fold( first ) != first || ( first >= 'a' && first <= 'z' );
+    int start = 0;
+    int from = 0;                                   // matches do not overlap
+    for( size_t c = 0; c < chunks.size(); start += chunks[ c ].length, ++c )
+    {
+        const Chunk& chunk = chunks[ c ];
+        bool candidate = true;
+        for( int j = 0; j < filterCount && candidate; ++j )
+            candidate = ( chunk.bits[ filter[ j ] >> 6 ] >> ( filter[ j ] & 63 ) ) & 1;
+        if( !candidate )
+            continue;
+
+        // verify: matches starting in this chunk may end in the next one
+        int stop = start + chunk.length;
+        if( stop > length_ - queryLength_ + 1 )
+            stop = length_ - queryLength_ + 1;
+        for( int p = start > from ? start : from; p < stop; ++p )
+        {
+            if( caseSensitive_ || !firstIsLetter )
+            {
+                const char* hit = (const char*)memchr( text_ + p, first, (size_t)( stop - p ) );
+                if( !hit )
+                    break;
+                p = (int)( hit - text_ );
+            }
+            if( MatchAt( text_ + p, query_, queryLength_, caseSensitive_ ) )
+            {
+                matches_.push_back( p );
+                if( matches_.Size >= maxMatches_ )
+                    return;
+                from = p + queryLength_;
+                p = from - 1;
+            }
+        }
+    }
+}
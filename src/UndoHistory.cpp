@@ -0,0 +1,257 @@
+#include "UndoHistory.h"
+
+#include <chrono>
+#include <vector>
+#include <string.h>
+
+static double Now()
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static void PutVarint( std::string& out_, size_t value_ )
+{
+    while( value_ >= 0x80 )
+    {
+        out_.push_back( (char)( value_ | 0x80 ) );
+        value_ >>= 7;
+    }
+    out_.push_back( (char)value_ );
+}
+
+static size_t GetVarint( const char*& p_ )
+{
+    size_t value = 0;
+    int shift = 0;
+    while( (unsigned char)*p_ & 0x80 )
+    {
+        value |= (size_t)( *p_++ & 0x7f ) << shift;
+        shift += 7;
+    }
+    value |= (size_t)(unsigned char)*p_++ << shift;
+    return value;
+}
+
+// Greedy LZ77. Tokens: varint literal count, the literals, varint match length (0 ends the
+// stream), varint distance back. A hash of the next 4 bytes gives the last place they were seen.
+static void Lz77Compress( const char* src_, size_t length_, std::string& out_ )
+{
+    static const int HASHBITS = 14;
+    std::vector<int> table( 1 << HASHBITS, -1 );
+    size_t literals = 0;
+    size_t i = 0;
+    while( i + 4 <= length_ )
+    {
+        unsigned int word;
+        memcpy( &word, src_ + i, 4 );
+        const unsigned int h = ( word * 2654435761u ) >> ( 32 - HASHBITS );
+        const int candidate = table[ h ];
+        table[ h ] = (int)i;
+        if( candidate < 0 || memcmp( src_ + candidate, src_ + i, 4 ) != 0 )
+        {
+            ++i;
+            continue;
+        }
+        size_t match = 4;
+        while( i + match < length_ && src_[ candidate + match ] == src_[ i + match ] )
+            ++match;
+        PutVarint( out_, i - literals );
+        out_.append( src_ + literals, i - literals );
+        PutVarint( out_, match );
+        PutVarint( out_, i - candidate );
+        i += match;
+        literals = i;
+    }
+    PutVarint( out_, length_ - literals );
+    out_.append( src_ + literals, length_ - literals );
+    PutVarint( out_, 0 );
+}
+
+static void Lz77Decompress( const char* src_, std::string& out_ )
+{
+    for( ;; )
+    {
+        const size_t literals = GetVarint( src_ );
+        out_.append( src_, literals );
+        src_ += literals;
+        const size_t match = GetVarint( src_ );
+        if( match == 0 )
+            break;
+        const size_t distance = GetVarint( src_ );
+        const size_t at = out_.size();
+        out_.resize( at + match );
+        // byte by byte: the match may overlap what it copies
+        char* data = &out_[ 0 ];
+        for( size_t k = 0; k < match; ++k )
+            data[ at + k ] = data[ at - distance + k ];
+    }
+}
+
+void UndoHistory::Record( const ImGui::MarkdownEdit& edit_, const char* deleted_, const char* inserted_ )
+{
+    if( edit_.IsEmpty() )
+        return;
+    while( (int)entries.size() > current )
+    {
+        bytes -= sizeof( Entry ) + entries.back().data.size();
+        entries.pop_back();
+    }
+    const double now = Now();
+    const bool merged = now - lastTime < MERGESECONDS && Merge( edit_, deleted_, inserted_ );
+    lastTime = now;
+    if( !merged )
+    {
+        entries.push_back( Entry() );
+        Entry& entry = entries.back();
+        entry.pos = edit_.pos;
+        entry.deleteLength = edit_.deleteLength;
+        entry.insertLength = edit_.insertLength;
+        entry.compressed = false;
+        entry.data.reserve( (size_t)edit_.deleteLength + edit_.insertLength );
+        entry.data.append( deleted_, edit_.deleteLength );
+        entry.data.append( inserted_, edit_.insertLength );
+        bytes += sizeof( Entry ) + entry.data.size();
+        current = (int)entries.size();
+        // every entry gets here once, when it goes KEEPRAW steps back
+        if( (int)entries.size() > KEEPRAW )
+            Compress( entries[ entries.size() - 1 - KEEPRAW ] );
+    }
+    Trim( budget );
+}
+
+void UndoHistory::Trim( size_t budget_ )
+{
+    while( bytes > budget_ && current > 0 )
+    {
+        bytes -= sizeof( Entry ) + entries.front().data.size();
+        entries.pop_front();
+        --current;
+    }
+    while( bytes > budget_ && (int)entries.size() > current )
+    {
+        bytes -= sizeof( Entry ) + entries.back().data.size();
+        entries.pop_back();
+    }
+}
+
+// Folds a small change into the newest entry: typing on from the end of the last insertion,
+// backspacing over it, or a run of Backspace / Delete. A new line starts a new entry.
+bool UndoHistory::Merge( const ImGui::MarkdownEdit& edit_, const char* deleted_, const char* inserted_ )
+{
+    if( entries.empty() || edit_.deleteLength > MERGEBYTES || edit_.insertLength > MERGEBYTES )
+        return false;
+    Entry& last = entries.back();
+    const size_t before = last.data.size();
+    if( last.compressed )
+        return false;
+    if( edit_.deleteLength == 0 )
+    {
+        if( edit_.pos != last.pos + last.insertLength || memchr( inserted_, '\n', edit_.insertLength ) )
+            return false;
+        last.data.append( inserted_, edit_.insertLength );
+        last.insertLength += edit_.insertLength;
+    }
+    else if( edit_.insertLength == 0 && last.insertLength > 0 )
+    {
+        if( edit_.pos < last.pos || edit_.pos + edit_.deleteLength != last.pos + last.insertLength )
+            return false;
+        last.data.resize( before - edit_.deleteLength );
+        last.insertLength -= edit_.deleteLength;
+    }
+    else if( edit_.insertLength == 0 )
+    {
+        if( edit_.pos == last.pos )
+            last.data.append( deleted_, edit_.deleteLength );
+        else if( edit_.pos + edit_.deleteLength == last.pos )
+        {
+            last.data.insert( 0, deleted_, edit_.deleteLength );
+            last.pos = edit_.pos;
+        }
+        else
+            return false;
+        last.deleteLength += edit_.deleteLength;
+    }
+    else
+        return false;
+    bytes = bytes - before + last.data.size();
+    if( last.deleteLength == 0 && last.insertLength == 0 )
+    {
+        // typed and erased again: nothing left to undo
+        bytes -= sizeof( Entry );
+        entries.pop_back();
+        current = (int)entries.size();
+    }
+    return true;
+}
+
+void UndoHistory::Compress( Entry& entry_ )
+{
+    if( entry_.compressed || entry_.data.size() < (size_t)MINCOMPRESS )
+        return;
+    std::string packed;
+    Lz77Compress( entry_.data.data(), entry_.data.size(), packed );
+    if( packed.size() >= entry_.data.size() / 4 * 3 )
+        return;                     // not worth the time it takes to unpack
+    bytes = bytes - entry_.data.size() + packed.size();
+    packed.shrink_to_fit();
+    entry_.data.swap( packed );
+    entry_.compressed = true;
+}
+
+void UndoHistory::Unpack( const Entry& entry_, std::string& text_ ) const
+{
+    text_.clear();
+    if( entry_.compressed )
+        Lz77Decompress( entry_.data.data(), text_ );
+    else
+        text_ = entry_.data;
+}
+
+bool UndoHistory::GetUndo( ImGui::MarkdownEdit* edit_, std::string& text_ ) const
+{
+    if( current == 0 )
+        return false;
+    const Entry& entry = entries[ current - 1 ];
+    edit_->pos = entry.pos;
+    edit_->deleteLength = entry.insertLength;
+    edit_->insertLength = entry.deleteLength;
+    Unpack( entry, text_ );
+    text_.resize( entry.deleteLength );
+    return true;
+}
+
+bool UndoHistory::GetRedo( ImGui::MarkdownEdit* edit_, std::string& text_ ) const
+{
+    if( current == (int)entries.size() )
+        return false;
+    const Entry& entry = entries[ current ];
+    edit_->pos = entry.pos;
+    edit_->deleteLength = entry.deleteLength;
+    edit_->insertLength = entry.insertLength;
+    Unpack( entry, text_ );
+    text_.erase( 0, entry.deleteLength );
+    return true;
+}
+
+// an entry that was stepped over is never merged into
+void UndoHistory::Undone()
+{
+    IM_ASSERT( current > 0 );
+    --current;
+    lastTime = 0.0;
+}
+
+void UndoHistory::Redone()
+{
+    IM_ASSERT( current < (int)entries.size() );
+    ++current;
+    lastTime = 0.0;
+}
+
+void UndoHistory::Clear()
+{
+    entries.clear();
+    current = 0;
+    bytes = 0;
+    lastTime = 0.0;
+}
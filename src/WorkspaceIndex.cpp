@@ -0,0 +1,593 @@
+#include "WorkspaceIndex.h"
+#include "imgui.h"
+
+#include <chrono>
+#include <algorithm>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+const char* WorkspaceIndex::INDEXNAME = ".mdindex";
+
+static const char IndexMagic[ 4 ] = { 'M', 'D', 'X', '1' };
+
+static double Now()
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static void PutVarint( std::string& out_, unsigned long long v_ )
+{
+    while( v_ >= 0x80 )
+    {
+        out_ += (char)( ( v_ & 0x7F ) | 0x80 );
+        v_ >>= 7;
+    }
+    out_ += (char)v_;
+}
+
+static bool GetVarint( const char*& p_, const char* end_, unsigned long long* v_ )
+{
+    *v_ = 0;
+    for( int shift = 0; p_ < end_ && shift < 64; shift += 7 )
+    {
+        unsigned char c = (unsigned char)*p_++;
+        *v_ |= (unsigned long long)( c & 0x7F ) << shift;
+        if( !( c & 0x80 ) )
+            return true;
+    }
+    return false;
+}
+
+static void PutString( std::string& out_, const std::string& s_ )
+{
+    PutVarint( out_, s_.size() );
+    out_ += s_;
+}
+
+static bool GetString( const char*& p_, const char* end_, std::string& s_ )
+{
+    unsigned long long length;
+    if( !GetVarint( p_, end_, &length ) || length > (unsigned long long)( end_ - p_ ) )
+        return false;
+    s_.assign( p_, (size_t)length );
+    p_ += length;
+    return true;
+}
+
+static bool IsMarkdownFile( const std::string& name_ )
+{
+    size_t length = name_.size();
+    return ( length > 3 && name_.compare( length - 3, 3, ".md" ) == 0 )
+        || ( length > 9 && name_.compare( length - 9, 9, ".markdown" ) == 0 );
+}
+
+static long long ModifiedTime( const struct stat& st_ )
+{
+#ifdef __linux__
+    return (long long)st_.st_mtim.tv_sec * 1000000000LL + st_.st_mtim.tv_nsec;
+#else
+    return (long long)st_.st_mtime * 1000000000LL;
+#endif
+}
+
+// Title (first H1 outside code blocks) and link targets of a note; images are not links
+static void ParseNote( const char* text_, size_t length_, WorkspaceEntry& entry_ )
+{
+    entry_.title.clear();
+    entry_.links.clear();
+    const char* end = text_ + length_;
+    bool inFence = false;
+    for( const char* line = text_; line < end; )
+    {
+        const char* lineEnd = (const char*)memchr( line, '\n', end - line );
+        if( !lineEnd )
+            lineEnd = end;
+        const char* p = line;
+        while( p < lineEnd && *p == ' ' && p - line < 3 )
+            ++p;
+        if( lineEnd - p >= 3 && ( strncmp( p, "```", 3 ) == 0 || strncmp( p, "~~~", 3 ) == 0 ) )
+            inFence = !inFence;
+        else if( !inFence )
+        {
+            if( entry_.title.empty() && lineEnd - p >= 2 && p[ 0 ] == '#' && p[ 1 ] == ' ' )
+            {
+                const char* b = p + 2;
+                const char* e = lineEnd;
+                while( b < e && *b == ' ' )
+                    ++b;
+                while( e > b && ( e[ -1 ] == ' ' || e[ -1 ] == '\r' ) )
+                    --e;
+                entry_.title.assign( b, e );
+            }
+            for( const char* q = p; q + 1 < lineEnd; ++q )
+            {
+                if( q[ 0 ] != ']' || q[ 1 ] != '(' )
+                    continue;
+                const char* open = q;
+                while( open > line && *open != '[' )
+                    --open;
+                const char* b = q + 2;
+                const char* e = b;
+                while( e < lineEnd && *e != ')' && *e != ' ' )
+                    ++e;
+                if( *open != '[' || e == lineEnd || e == b || ( open > line && open[ -1 ] == '!' ) )
+                    continue;
+                std::string link( b, e );
+                if( std::find( entry_.links.begin(), entry_.links.end(), link ) == entry_.links.end() )
+                    entry_.links.push_back( link );
+            }
+        }
+        line = lineEnd + 1;
+    }
+}
+
+WorkspaceIndex::WorkspaceIndex() : watchFd( -1 ), stopping( false ), snapshot( std::make_shared<WorkspaceEntries>() ), version( 0 ), scanning( false ), treeVersion( ~0u )
+{
+    stopPipe[ 0 ] = stopPipe[ 1 ] = -1;
+}
+
+bool WorkspaceIndex::Open( const char* root_ )
+{
+    Close();
+    root = root_;
+    while( root.size() > 1 && root.back() == '/' )
+        root.pop_back();
+    struct stat st;
+    if( stat( root.c_str(), &st ) != 0 || !S_ISDIR( st.st_mode ) || pipe( stopPipe ) != 0 )
+        return false;
+
+    // what the index says is shown until the walk has checked it
+    std::shared_ptr<WorkspaceEntries> entries = std::make_shared<WorkspaceEntries>();
+    Load( *entries );
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        snapshot = entries;
+    }
+    ++version;
+    scanning = true;
+    stopping = false;
+    worker = std::thread( &WorkspaceIndex::WorkerMain, this );
+    return true;
+}
+
+void WorkspaceIndex::Close()
+{
+    if( !worker.joinable() )
+        return;
+    // the flag stops a walk in progress, the pipe wakes the worker from poll(); it is joined whatever
+    // happens, a std::thread destroyed while joinable would terminate the program
+    stopping = true;
+    char c = 0;
+    while( write( stopPipe[ 1 ], &c, 1 ) < 0 && errno == EINTR )
+        ;
+    worker.join();
+    close( stopPipe[ 0 ] );
+    close( stopPipe[ 1 ] );
+    stopPipe[ 0 ] = stopPipe[ 1 ] = -1;
+}
+
+std::shared_ptr<const WorkspaceEntries> WorkspaceIndex::Entries() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return snapshot;
+}
+
+void WorkspaceIndex::Publish( const EntryMap& files_ )
+{
+    std::shared_ptr<WorkspaceEntries> entries = std::make_shared<WorkspaceEntries>();
+    entries->reserve( files_.size() );
+    for( const auto& file : files_ )
+        entries->push_back( file.second );
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        snapshot = entries;
+    }
+    ++version;
+}
+
+bool WorkspaceIndex::Load( WorkspaceEntries& entries_ )
+{
+    std::string data;
+    int fd = open( ( root + "/" + INDEXNAME ).c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 )
+        return false;
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+        data.resize( (size_t)st.st_size );
+        size_t got = 0;
+        ssize_t n;
+        while( got < data.size() && ( n = read( fd, &data[ got ], data.size() - got ) ) > 0 )
+            got += (size_t)n;
+        data.resize( got );
+    }
+    close( fd );
+
+    const char* p = data.data();
+    const char* end = p + data.size();
+    unsigned long long count;
+    if( data.size() < 4 || memcmp( p, IndexMagic, 4 ) != 0 )
+        return false;
+    p += 4;
+    if( !GetVarint( p, end, &count ) )
+        return false;
+    std::string path;
+    entries_.reserve( (size_t)std::min<unsigned long long>( count, data.size() ) );
+    for( unsigned long long i = 0; i < count; ++i )
+    {
+        entries_.push_back( WorkspaceEntry() );
+        WorkspaceEntry& entry = entries_.back();
+        unsigned long long shared, size, mtime, links;
+        std::string suffix;
+        if( !GetVarint( p, end, &shared ) || shared > path.size() || !GetString( p, end, suffix )
+            || !GetVarint( p, end, &size ) || !GetVarint( p, end, &mtime ) || !GetString( p, end, entry.title )
+            || !GetVarint( p, end, &links ) )
+        {
+            entries_.clear();
+            return false;
+        }
+        path.resize( (size_t)shared );
+        path += suffix;
+        entry.path = path;
+        entry.size = (long long)size;
+        entry.mtime = (long long)mtime;
+        for( unsigned long long l = 0; l < links; ++l )
+        {
+            std::string link;
+            if( !GetString( p, end, link ) )
+            {
+                entries_.clear();
+                return false;
+            }
+            entry.links.push_back( std::move( link ) );
+        }
+    }
+    return true;
+}
+
+bool WorkspaceIndex::Save( const EntryMap& files_ )
+{
+    std::string data( IndexMagic, 4 );
+    PutVarint( data, files_.size() );
+    const std::string* previous = nullptr;
+    for( const auto& file : files_ )
+    {
+        const WorkspaceEntry& entry = file.second;
+        size_t shared = 0;
+        if( previous )
+        {
+            size_t limit = std::min( previous->size(), entry.path.size() );
+            while( shared < limit && ( *previous )[ shared ] == entry.path[ shared ] )
+                ++shared;
+        }
+        PutVarint( data, shared );
+        PutString( data, entry.path.substr( shared ) );
+        PutVarint( data, (unsigned long long)entry.size );
+        PutVarint( data, (unsigned long long)entry.mtime );
+        PutString( data, entry.title );
+        PutVarint( data, entry.links.size() );
+        for( const std::string& link : entry.links )
+            PutString( data, link );
+        previous = &entry.path;
+    }
+
+    // the index is a cache: a rename keeps readers from seeing half of it, no fsync needed
+    std::string path = root + "/" + INDEXNAME;
+    std::string tmp = path + ".tmp";
+    int fd = open( tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( fd < 0 )
+        return false;
+    const char* p = data.data();
+    size_t left = data.size();
+    ssize_t n = 0;
+    while( left > 0 && ( n = write( fd, p, left ) ) > 0 )
+    {
+        p += n;
+        left -= (size_t)n;
+    }
+    close( fd );
+    if( left > 0 || rename( tmp.c_str(), path.c_str() ) != 0 )
+    {
+        unlink( tmp.c_str() );
+        return false;
+    }
+    return true;
+}
+
+// Re-reads one note (path relative to the root). Returns true if its entry changed.
+bool WorkspaceIndex::Refresh( const std::string& path_, EntryMap& files_ )
+{
+    std::string full = root + "/" + path_;
+    struct stat st;
+    if( stat( full.c_str(), &st ) != 0 || !S_ISREG( st.st_mode ) )
+        return files_.erase( path_ ) > 0;
+    auto it = files_.find( path_ );
+    if( it != files_.end() && it->second.size == (long long)st.st_size && it->second.mtime == ModifiedTime( st ) )
+        return false;
+
+    WorkspaceEntry entry;
+    entry.path = path_;
+    entry.size = (long long)st.st_size;
+    entry.mtime = ModifiedTime( st );
+    int fd = open( full.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd >= 0 )
+    {
+        std::string text( (size_t)std::min<long long>( st.st_size, MAXPARSEBYTES ), '\0' );
+        size_t got = 0;
+        ssize_t n;
+        while( got < text.size() && ( n = read( fd, &text[ got ], text.size() - got ) ) > 0 )
+            got += (size_t)n;
+        close( fd );
+        ParseNote( text.data(), got, entry );
+    }
+    files_[ path_ ] = std::move( entry );
+    return true;
+}
+
+void WorkspaceIndex::AddWatch( const std::string& dir_ )
+{
+#ifdef __linux__
+    if( watchFd < 0 )
+        return;
+    int wd = inotify_add_watch( watchFd, ( root + "/" + dir_ ).c_str(),
+        IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR );
+    if( wd >= 0 )
+        watches[ wd ] = dir_;
+#else
+    (void)dir_;
+#endif
+}
+
+// Walks dir_ (relative, "" for the root): every note is refreshed and marked seen, every folder watched
+void WorkspaceIndex::Scan( const std::string& dir_, EntryMap& files_, std::set<std::string>* seen_, bool* changed_ )
+{
+    if( stopping )
+        return;
+    AddWatch( dir_ );
+    std::string full = dir_.empty() ? root : root + "/" + dir_;
+    DIR* dir = opendir( full.c_str() );
+    if( !dir )
+        return;
+    std::vector<std::string> folders;
+    while( dirent* ent = readdir( dir ) )
+    {
+        if( stopping )
+            break;
+        if( ent->d_name[ 0 ] == '.' )
+            continue;                               // ., .., the index itself and hidden folders
+        std::string path = dir_.empty() ? std::string( ent->d_name ) : dir_ + "/" + ent->d_name;
+        bool isDir = ent->d_type == DT_DIR;
+        if( ent->d_type == DT_UNKNOWN )
+        {
+            struct stat st;
+            isDir = stat( ( root + "/" + path ).c_str(), &st ) == 0 && S_ISDIR( st.st_mode );
+        }
+        if( isDir )
+            folders.push_back( path );
+        else if( IsMarkdownFile( path ) )
+        {
+            if( seen_ )
+                seen_->insert( path );
+            *changed_ |= Refresh( path, files_ );
+        }
+    }
+    closedir( dir );
+    for( const std::string& folder : folders )
+        Scan( folder, files_, seen_, changed_ );
+}
+
+void WorkspaceIndex::WorkerMain()
+{
+    EntryMap files;
+    for( const WorkspaceEntry& entry : *Entries() )
+        files.emplace_hint( files.end(), entry.path, entry );
+#ifdef __linux__
+    watchFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+#endif
+    // check the loaded index against the disk: new and changed notes are read, missing ones dropped
+    std::set<std::string> seen;
+    bool changed = false;
+    Scan( "", files, &seen, &changed );
+    // when Close() interrupted the walk it is incomplete: what it did not see is not gone, and
+    // nothing is published; the loop below is skipped and the watches are released after it
+    if( !stopping )
+    {
+        for( auto it = files.begin(); it != files.end(); )
+        {
+            if( seen.count( it->first ) )
+                ++it;
+            else
+            {
+                it = files.erase( it );
+                changed = true;
+            }
+        }
+        if( changed )
+        {
+            Publish( files );
+            Save( files );
+        }
+    }
+    scanning = false;
+
+    double publishAt = 0.0, saveAt = 0.0;       // pending publication / save, 0 if none
+    while( !stopping )
+    {
+        pollfd fds[ 2 ] = { { stopPipe[ 0 ], POLLIN, 0 }, { watchFd, POLLIN, 0 } };
+        double now = Now();
+        double wake = publishAt > 0.0 ? publishAt : ( saveAt > 0.0 ? saveAt : 0.0 );
+        // never wait forever: if Close() could not write to the pipe, the flag still ends the loop
+        int timeout = wake > 0.0 ? std::max( 0, (int)( ( wake - now ) * 1000.0 ) + 1 ) : ( watchFd >= 0 ? 1000 : 10000 );
+        int ready = poll( fds, watchFd >= 0 ? 2 : 1, timeout );
+        if( stopping || ( ready > 0 && ( fds[ 0 ].revents & POLLIN ) ) )
+            break;
+
+        bool dirty = false;
+#ifdef __linux__
+        if( ready > 0 && ( fds[ 1 ].revents & POLLIN ) )
+        {
+            alignas( inotify_event ) char buffer[ 64 * 1024 ];
+            ssize_t length;
+            while( ( length = read( watchFd, buffer, sizeof( buffer ) ) ) > 0 )
+            {
+                for( char* p = buffer; p < buffer + length; )
+                {
+                    const inotify_event* event = (const inotify_event*)p;
+                    p += sizeof( inotify_event ) + event->len;
+                    if( event->mask & IN_Q_OVERFLOW )
+                    {
+                        Scan( "", files, NULL, &dirty );
+                        continue;
+                    }
+                    if( event->mask & IN_IGNORED )
+                    {
+                        watches.erase( event->wd );
+                        continue;
+                    }
+                    auto watch = watches.find( event->wd );
+                    if( watch == watches.end() || event->len == 0 || event->name[ 0 ] == '.' )
+                        continue;
+                    std::string path = watch->second.empty() ? std::string( event->name ) : watch->second + "/" + event->name;
+                    if( event->mask & IN_ISDIR )
+                    {
+                        if( event->mask & ( IN_CREATE | IN_MOVED_TO ) )
+                            Scan( path, files, NULL, &dirty );
+                        else if( event->mask & ( IN_DELETE | IN_MOVED_FROM ) )
+                        {
+                            // everything under the folder went with it
+                            std::string prefix = path + "/";
+                            auto it = files.lower_bound( prefix );
+                            while( it != files.end() && it->first.compare( 0, prefix.size(), prefix ) == 0 )
+                            {
+                                it = files.erase( it );
+                                dirty = true;
+                            }
+                        }
+                    }
+                    else if( IsMarkdownFile( path ) )
+                        dirty |= Refresh( path, files );
+                }
+            }
+        }
+#else
+        if( ready == 0 && wake == 0.0 )
+            Scan( "", files, NULL, &dirty );       // no change notifications: poll the folder
+#endif
+        now = Now();
+        if( dirty )
+        {
+            if( publishAt == 0.0 )
+                publishAt = now + PUBLISHSECONDS;
+            saveAt = now + SAVESECONDS;
+        }
+        if( publishAt > 0.0 && now >= publishAt )
+        {
+            Publish( files );
+            publishAt = 0.0;
+        }
+        if( saveAt > 0.0 && now >= saveAt && publishAt == 0.0 )
+        {
+            Save( files );
+            saveAt = 0.0;
+        }
+    }
+
+    if( saveAt > 0.0 )
+        Save( files );
+    if( watchFd >= 0 )
+        close( watchFd );
+    watchFd = -1;
+    watches.clear();
+}
+
+void WorkspaceIndex::BuildTree()
+{
+    tree.clear();
+    tree.push_back( TreeNode() );
+    // paths are sorted, so the notes of a folder are contiguous: the folders of the previous
+    // path that are also a prefix of this one stay open
+    std::vector<int> stack( 1, 0 );
+    std::vector<std::string> prefixes( 1, std::string() );
+    const WorkspaceEntries& entries = *treeEntries;
+    for( int i = 0; i < (int)entries.size(); ++i )
+    {
+        const std::string& path = entries[ i ].path;
+        while( stack.size() > 1 && path.compare( 0, prefixes.back().size(), prefixes.back() ) != 0 )
+        {
+            stack.pop_back();
+            prefixes.pop_back();
+        }
+        size_t start = prefixes.back().size();
+        for( size_t slash; ( slash = path.find( '/', start ) ) != std::string::npos; start = slash + 1 )
+        {
+            TreeNode folder;
+            folder.name = path.substr( start, slash - start );
+            tree.push_back( folder );
+            tree[ stack.back() ].folders.push_back( (int)tree.size() - 1 );
+            stack.push_back( (int)tree.size() - 1 );
+            prefixes.push_back( path.substr( 0, slash + 1 ) );
+        }
+        TreeNode file;
+        file.name = path.substr( start );
+        file.entry = i;
+        tree.push_back( file );
+        tree[ stack.back() ].files.push_back( (int)tree.size() - 1 );
+    }
+}
+
+void WorkspaceIndex::ShowNode( int node_, std::string& clicked_ )
+{
+    // folders first, then the notes; long folders are clipped
+    for( int child : tree[ node_ ].folders )
+    {
+        if( ImGui::TreeNode( (void*)(intptr_t)child, "%s", tree[ child ].name.c_str() ) )
+        {
+            ShowNode( child, clicked_ );
+            ImGui::TreePop();
+        }
+    }
+    const std::vector<int>& files = tree[ node_ ].files;
+    ImGuiListClipper clipper;
+    clipper.Begin( (int)files.size() );
+    while( clipper.Step() )
+    {
+        for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i )
+        {
+            const TreeNode& file = tree[ files[ i ] ];
+            const WorkspaceEntry& entry = ( *treeEntries )[ file.entry ];
+            ImGui::PushID( files[ i ] );
+            if( ImGui::Selectable( file.name.c_str() ) )
+                clicked_ = root + "/" + entry.path;
+            if( ImGui::IsItemHovered() && ( !entry.title.empty() || !entry.links.empty() ) )
+                ImGui::SetTooltip( "%s\n%d links", entry.title.c_str(), (int)entry.links.size() );
+            ImGui::PopID();
+        }
+    }
+}
+
+std::string WorkspaceIndex::ShowTree()
+{
+    if( treeVersion != version )
+    {
+        treeVersion = version;
+        treeEntries = Entries();
+        BuildTree();
+    }
+    std::string clicked;
+    ImGui::Begin( "files" );
+    ImGui::TextDisabled( "%s: %d notes%s", root.c_str(), (int)treeEntries->size(), scanning ? " (scanning)" : "" );
+    ImGui::Separator();
+    ImGui::BeginChild( "tree" );
+    ShowNode( 0, clicked );
+    ImGui::EndChild();
+    ImGui::End();
+    return clicked;
+}
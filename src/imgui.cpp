@@ -1931,14 +1931,117 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Well formed 2 and 3 byte sequences (Latin, Greek, Cyrillic, CJK...) are decoded here, anything else by
+// ImTextCharFromUtf8(), which also validates. Both give the same result for these sequences.
+static inline int ImTextCharFromUtf8_fast(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const unsigned int b0 = (unsigned char)in_text[0];
+    if (b0 < 0x80)
+    {
+        *out_char = b0;
+        return 1;
+    }
+    // With no in_text_end, a tail byte is only read after a non-zero one, so never past the terminator.
+    const ptrdiff_t avail = in_text_end ? in_text_end - in_text : 3;
+    if ((b0 & 0xe0) == 0xc0 && b0 >= 0xc2 && avail >= 2 && (in_text[1] & 0xc0) == 0x80)
+    {
+        *out_char = ((b0 & 0x1f) << 6) | (in_text[1] & 0x3f);
+        return 2;
+    }
+    if ((b0 & 0xf0) == 0xe0 && avail >= 3 && (in_text[1] & 0xc0) == 0x80 && (in_text[2] & 0xc0) == 0x80)
+    {
+        const unsigned int c = ((b0 & 0x0f) << 12) | ((in_text[1] & 0x3f) << 6) | (in_text[2] & 0x3f);
+        if (c >= 0x800 && (c < 0xd800 || c > 0xdfff))
+        {
+            *out_char = c;
+            return 3;
+        }
+    }
+    return ImTextCharFromUtf8(out_char, in_text, in_text_end);
+}
+
+#ifdef IMGUI_ENABLE_SSE
+// True when the 16 bytes are all ASCII and none is 0: they convert one to one, with nothing to validate.
+// The blocks are only used with an explicit in_text_end, as a NUL terminated string may end inside them.
+static inline bool ImTextIsAsciiBlock(__m128i v)
+{
+    return _mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, _mm_setzero_si128()))) == 0;
+}
+
+static inline void ImTextWidenAsciiBlock(ImWchar* out, __m128i v)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+#ifdef IMGUI_USE_WCHAR32
+    _mm_storeu_si128((__m128i*)out + 0, _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)out + 1, _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)out + 2, _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i*)out + 3, _mm_unpackhi_epi16(hi, zero));
+#else
+    _mm_storeu_si128((__m128i*)out + 0, lo);
+    _mm_storeu_si128((__m128i*)out + 1, hi);
+#endif
+}
+
+// Looks at 16 characters: returns 0 when one of them is 0, 1 when they are all ASCII (and then narrows them to out), 2 otherwise.
+static inline int ImTextNarrowAsciiBlock(char* out, const ImWchar* in)
+{
+    const __m128i zero = _mm_setzero_si128();
+#ifdef IMGUI_USE_WCHAR32
+    const __m128i a = _mm_loadu_si128((const __m128i*)in + 0);
+    const __m128i b = _mm_loadu_si128((const __m128i*)in + 1);
+    const __m128i c = _mm_loadu_si128((const __m128i*)in + 2);
+    const __m128i d = _mm_loadu_si128((const __m128i*)in + 3);
+    const __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32((int)0xffffff80));
+    const __m128i nul = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(a, zero), _mm_cmpeq_epi32(b, zero)), _mm_or_si128(_mm_cmpeq_epi32(c, zero), _mm_cmpeq_epi32(d, zero)));
+    if (_mm_movemask_epi8(nul) != 0)
+        return 0;
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xffff)
+        return 2;
+    _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+#else
+    const __m128i a = _mm_loadu_si128((const __m128i*)in + 0);
+    const __m128i b = _mm_loadu_si128((const __m128i*)in + 1);
+    const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16((short)0xff80));
+    if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(a, zero), _mm_cmpeq_epi16(b, zero))) != 0)
+        return 0;
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff)
+        return 2;
+    _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(a, b));
+#endif
+    return 1;
+}
+#endif
+
+// Runs of ASCII are converted 16 bytes at a time (with IMGUI_ENABLE_SSE and an in_text_end), the rest one character
+// at a time. After a block that is not all ASCII the next 16 characters go one at a time, so text with few ASCII
+// runs does not pay for a failed test on every character.
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+    int scalar_count = 0;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IMGUI_ENABLE_SSE
+        if (scalar_count == 0 && in_text_end && in_text_end - in_text >= 16 && buf_end - buf_out > 16)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)in_text);
+            if (ImTextIsAsciiBlock(v))
+            {
+                ImTextWidenAsciiBlock(buf_out, v);
+                buf_out += 16;
+                in_text += 16;
+                continue;
+            }
+            scalar_count = 16;
+        }
+        if (scalar_count > 0)
+            scalar_count--;
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextCharFromUtf8_fast(&c, in_text, in_text_end);
         if (c == 0)
             break;
         *buf_out++ = (ImWchar)c;
@@ -1952,10 +2055,25 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
 int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
 {
     int char_count = 0;
+    int scalar_count = 0;
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IMGUI_ENABLE_SSE
+        if (scalar_count == 0 && in_text_end && in_text_end - in_text >= 16)
+        {
+            if (ImTextIsAsciiBlock(_mm_loadu_si128((const __m128i*)in_text)))
+            {
+                char_count += 16;
+                in_text += 16;
+                continue;
+            }
+            scalar_count = 16;
+        }
+        if (scalar_count > 0)
+            scalar_count--;
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextCharFromUtf8_fast(&c, in_text, in_text_end);
         if (c == 0)
             break;
         char_count++;
@@ -2028,6 +2146,42 @@ int ImTextStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, con
     const char* buf_end = out_buf + out_buf_size;
     while (buf_p < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IMGUI_ENABLE_SSE
+        // 16 characters with no 0 and room for 4 bytes each need no bounds checks: all ASCII they are narrowed
+        // at once, else converted in a loop with nothing else to test.
+        if (in_text_end && in_text_end - in_text >= 16 && buf_end - buf_p > 16 * 4)
+        {
+            const int block = ImTextNarrowAsciiBlock(buf_p, in_text);
+            if (block == 1)
+            {
+                buf_p += 16;
+                in_text += 16;
+                continue;
+            }
+            if (block == 2)
+            {
+                // Below 0x10000 the three bytes are always written and the length picked without a branch: in mixed
+                // text whether the next character is ASCII, 2 or 3 bytes is a coin toss for the branch predictor.
+                for (int n = 0; n < 16; n++)
+                {
+                    unsigned int c = (unsigned int)in_text[n];
+                    if (c >= 0x10000)
+                    {
+                        buf_p += ImTextCharToUtf8_inline(buf_p, 4, c);
+                        continue;
+                    }
+                    const unsigned int three = c >= 0x800;
+                    const unsigned int extra = (c >= 0x80) + three;     // bytes after the first
+                    buf_p[0] = (char)(((0xe0c000 >> (extra * 8)) & 0xff) | (c >> (extra * 6)));
+                    buf_p[1] = (char)(0x80 | ((c >> (three * 6)) & 0x3f));
+                    buf_p[2] = (char)(0x80 | (c & 0x3f));
+                    buf_p += 1 + extra;
+                }
+                in_text += 16;
+                continue;
+            }
+        }
+#endif
         unsigned int c = (unsigned int)(*in_text++);
         if (c < 0x80)
             *buf_p++ = (char)c;
@@ -2041,6 +2195,31 @@ int ImTextStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, con
 int ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end)
 {
     int bytes_count = 0;
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_USE_WCHAR32)
+    // 8 characters at a time up to the first 0: 1 byte each, plus 1 from 0x80 and 1 more from 0x800 (an ImWchar16
+    // never takes 4). The compares give -1 per lane, summed in 32-bit lanes and added up once at the end.
+    if (in_text_end)
+    {
+        const __m128i bias = _mm_set1_epi16((short)0x8000); // unsigned compares done as signed ones
+        const __m128i above_7f = _mm_set1_epi16((short)(0x7f ^ 0x8000));
+        const __m128i above_7ff = _mm_set1_epi16((short)(0x7ff ^ 0x8000));
+        __m128i extra = _mm_setzero_si128();
+        while (in_text_end - in_text >= 8)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)in_text);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_setzero_si128())) != 0)
+                break;
+            const __m128i biased = _mm_xor_si128(v, bias);
+            const __m128i minus = _mm_add_epi16(_mm_cmpgt_epi16(biased, above_7f), _mm_cmpgt_epi16(biased, above_7ff));
+            extra = _mm_sub_epi32(extra, _mm_madd_epi16(minus, _mm_set1_epi16(1)));
+            bytes_count += 8;
+            in_text += 8;
+        }
+        extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(1, 0, 3, 2)));
+        extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(2, 3, 0, 1)));
+        bytes_count += _mm_cvtsi128_si32(extra);
+    }
+#endif
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
         unsigned int c = (unsigned int)(*in_text++);
@@ -18349,6 +18528,9 @@ void ImGui::DebugNodeFont(ImFont* font)
     Text("Ellipsis character: '%s' (U+%04X)", ImTextCharToUtf8(c_str, font->EllipsisChar), font->EllipsisChar);
     const int surface_sqrt = (int)ImSqrt((float)font->MetricsTotalSurface);
     Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+    Text("Lookup tables: %d bytes (%d dense codepoints, %d pages of %d)",
+        (int)(font->IndexAdvanceX.size_in_bytes() + font->IndexLookup.size_in_bytes() + font->PageMap.size_in_bytes() + font->PagedAdvanceX.size_in_bytes() + font->PagedLookup.size_in_bytes()),
+        font->IndexLookup.Size, font->PagedLookup.Size / IM_FONT_PAGE_SIZE, IM_FONT_PAGE_SIZE);
     for (int config_i = 0; config_i < font->ConfigDataCount; config_i++)
         if (font->ConfigData)
             if (const ImFontConfig* cfg = &font->ConfigData[config_i])
@@ -1984,6 +1984,8 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexSdfSpread = 4;
+    BuildParallelForFn = NULL;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2079,6 +2081,25 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+ImFont* ImFontAtlas::AddFontScaled(ImFont* src_font, float scale)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(Fonts.contains(src_font));
+    IM_ASSERT(src_font->ScaledSourceN < 0 && "Scale the source font instead");
+    int src_n = 0;
+    while (Fonts[src_n] != src_font)
+        src_n++;
+    ImFont* font = IM_NEW(ImFont);
+    font->ScaledSourceN = src_n;
+    font->ScaledSourceScale = scale;
+    Fonts.push_back(font);
+
+    // Filled by the next build: the glyphs are not rasterized again, but the fonts of the atlas must all be built together
+    TexReady = false;
+    ClearTexData();
+    return font;
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
@@ -2349,6 +2370,75 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Signed distance fields are slow to compute (every texel measures its distance to every edge of the outline), so each glyph is a job,
+// run in parallel by ImFontAtlas::BuildParallelForFn when the application provides it.
+struct ImFontBuildSdfJob
+{
+    ImFontBuildSrcData* Src;
+    float               Scale;
+    int                 GlyphIndex;         // Index into Src->GlyphsList, Rects and PackedChars
+};
+
+struct ImFontBuildSdfJobs
+{
+    ImFontAtlas*                Atlas;
+    ImVector<ImFontBuildSdfJob> Jobs;
+};
+
+// Render the distance field of a packed glyph, and fill its packed char the way stbtt_PackFontRangesRenderIntoRects() does, so stbtt_GetPackedQuad()
+// gives the glyph quad. Texels are 128 on the outline and change by 128 / TexSdfSpread per pixel of distance. Jobs write to disjoint rectangles.
+static void ImFontAtlasBuildRenderSdfGlyph(void* user_data, int job_n)
+{
+    ImFontBuildSdfJobs* jobs = (ImFontBuildSdfJobs*)user_data;
+    ImFontAtlas* atlas = jobs->Atlas;
+    const ImFontBuildSdfJob& job = jobs->Jobs[job_n];
+    ImFontBuildSrcData* src_tmp = job.Src;
+    const stbrp_rect& r = src_tmp->Rects[job.GlyphIndex];
+    stbtt_packedchar& pc = src_tmp->PackedChars[job.GlyphIndex];
+    const int spread = ImMax(atlas->TexSdfSpread, 1);
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp->FontInfo, src_tmp->GlyphsList[job.GlyphIndex]);
+    int advance, lsb, w = 0, h = 0, xoff = 0, yoff = 0;
+    stbtt_GetGlyphHMetrics(&src_tmp->FontInfo, glyph_index_in_font, &advance, &lsb);
+    if (unsigned char* field = stbtt_GetGlyphSDF(&src_tmp->FontInfo, job.Scale, glyph_index_in_font, spread, 128, 128.0f / spread, &w, &h, &xoff, &yoff))
+    {
+        for (int y = 0; y < h; y++)
+            memcpy(atlas->TexPixelsAlpha8 + (r.y + y) * atlas->TexWidth + r.x, field + y * w, (size_t)w);
+        stbtt_FreeSDF(field, src_tmp->FontInfo.userdata);
+    }
+    pc.x0 = (unsigned short)r.x;
+    pc.y0 = (unsigned short)r.y;
+    pc.x1 = (unsigned short)(r.x + w);
+    pc.y1 = (unsigned short)(r.y + h);
+    pc.xoff = (float)xoff;
+    pc.yoff = (float)yoff;
+    pc.xoff2 = (float)(xoff + w);
+    pc.yoff2 = (float)(yoff + h);
+    pc.xadvance = job.Scale * advance;
+}
+
+static void ImFontAtlasBuildRenderSdfGlyphs(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array)
+{
+    ImFontBuildSdfJobs jobs;
+    jobs.Atlas = atlas;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
+        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+            if (src_tmp.Rects[glyph_i].was_packed)
+            {
+                ImFontBuildSdfJob job = { &src_tmp, scale, glyph_i };
+                jobs.Jobs.push_back(job);
+            }
+    }
+    if (atlas->BuildParallelForFn)
+        atlas->BuildParallelForFn(jobs.Jobs.Size, ImFontAtlasBuildRenderSdfGlyph, &jobs);
+    else
+        for (int job_n = 0; job_n < jobs.Jobs.Size; job_n++)
+            ImFontAtlasBuildRenderSdfGlyph(&jobs, job_n);
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2484,6 +2574,16 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
+            if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+            {
+                // Same box as stbtt_GetGlyphSDF(): the outline at 1x plus the spread on each side (empty glyphs have no field)
+                stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+                const int spread = (x0 != x1 && y0 != y1) ? ImMax(atlas->TexSdfSpread, 1) * 2 : 0;
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + spread + padding);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + spread + padding);
+                total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+                continue;
+            }
             stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
             src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
             src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
@@ -2533,6 +2633,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+        ImFontAtlasBuildRenderSdfGlyphs(atlas, src_tmp_array);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[src_i];
@@ -2540,6 +2642,12 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         if (src_tmp.GlyphsCount == 0)
             continue;
 
+        if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+        {
+            src_tmp.Rects = NULL;
+            continue;
+        }
+
         stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
 
         // Apply multiply operator
@@ -2766,6 +2874,10 @@ static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 // Note: this is called / shared by both the stb_truetype and the FreeType builder
 void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 {
+    // Mouse cursors and baked lines are coverage images, which the distance field threshold would distort
+    if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+        atlas->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines;
+
     // Register texture region for mouse cursors or standard white pixels
     if (atlas->PackIdMouseCursors < 0)
     {
@@ -2806,6 +2918,22 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
         r->Font->AddGlyph(NULL, (ImWchar)r->GlyphID, r->GlyphOffset.x, r->GlyphOffset.y, r->GlyphOffset.x + r->Width, r->GlyphOffset.y + r->Height, uv0.x, uv0.y, uv1.x, uv1.y, r->GlyphAdvanceX);
     }
 
+    // Copy the fonts added with AddFontScaled() from their source again: their glyphs (and UV) are the ones just built
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+    {
+        ImFont* font = atlas->Fonts[i];
+        if (font->ScaledSourceN < 0)
+            continue;
+        const int src_n = font->ScaledSourceN;
+        const float scale = font->ScaledSourceScale;
+        IM_ASSERT(src_n < i && atlas->Fonts[src_n]->ScaledSourceN < 0);
+        *font = *atlas->Fonts[src_n];
+        font->Scale *= scale;
+        font->ScaledSourceN = src_n;
+        font->ScaledSourceScale = scale;
+        font->DirtyLookupTables = true; // FallbackGlyph points into the glyphs of the source
+    }
+
     // Build all fonts lookup tables
     for (int i = 0; i < atlas->Fonts.Size; i++)
         if (atlas->Fonts[i]->DirtyLookupTables)
@@ -3126,6 +3254,8 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    ScaledSourceN = -1;
+    ScaledSourceScale = 1.0f;
 }
 
 ImFont::~ImFont()
@@ -3140,6 +3270,9 @@ void    ImFont::ClearOutputData()
     Glyphs.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    PageMap.clear();
+    PagedAdvanceX.clear();
+    PagedLookup.clear();
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
@@ -3155,6 +3288,41 @@ static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_cha
     return (ImWchar)-1;
 }
 
+// Entry of codepoint 'c' in the lookup tables: in IndexLookup/IndexAdvanceX below IndexLookup.Size, else in the page holding 'c'.
+// Returns NULL if that page is not allocated, unless 'create' is set: the page is then appended, empty, with advances of 'fill_advance_x'.
+static ImWchar* ImFontLookupEntry(ImFont* font, unsigned int c, bool create, float fill_advance_x, float** out_advance_x)
+{
+    if (c < (unsigned int)font->IndexLookup.Size)
+    {
+        *out_advance_x = &font->IndexAdvanceX.Data[c];
+        return &font->IndexLookup.Data[c];
+    }
+    const int page_n = (int)(c >> IM_FONT_PAGE_SHIFT);
+    if (page_n >= font->PageMap.Size || font->PageMap.Data[page_n] == 0)
+    {
+        if (!create)
+            return NULL;
+        if (page_n >= font->PageMap.Size)
+            font->PageMap.resize(page_n + 1, (ImU16)0);
+        font->PageMap.Data[page_n] = (ImU16)(font->PagedLookup.Size / IM_FONT_PAGE_SIZE + 1);
+        font->PagedAdvanceX.resize(font->PagedAdvanceX.Size + IM_FONT_PAGE_SIZE, fill_advance_x);
+        font->PagedLookup.resize(font->PagedLookup.Size + IM_FONT_PAGE_SIZE, (ImWchar)-1);
+    }
+    const int n = ((font->PageMap.Data[page_n] - 1) << IM_FONT_PAGE_SHIFT) + (int)(c & (IM_FONT_PAGE_SIZE - 1));
+    *out_advance_x = &font->PagedAdvanceX.Data[n];
+    return &font->PagedLookup.Data[n];
+}
+
+static inline ImWchar ImFontLookupIndex(const ImFont* font, unsigned int c)
+{
+    if (c < (unsigned int)font->IndexLookup.Size)
+        return font->IndexLookup.Data[c];
+    const unsigned int page_n = c >> IM_FONT_PAGE_SHIFT;
+    if (page_n >= (unsigned int)font->PageMap.Size || font->PageMap.Data[page_n] == 0)
+        return (ImWchar)-1;
+    return font->PagedLookup.Data[((font->PageMap.Data[page_n] - 1) << IM_FONT_PAGE_SHIFT) + (c & (IM_FONT_PAGE_SIZE - 1))];
+}
+
 void ImFont::BuildLookupTable()
 {
     int max_codepoint = 0;
@@ -3165,14 +3333,36 @@ void ImFont::BuildLookupTable()
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    PageMap.clear();
+    PagedAdvanceX.clear();
+    PagedLookup.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
-    GrowIndex(max_codepoint + 1);
+    const int dense_size = ImMin(max_codepoint + 1, IM_FONT_DENSE_CODEPOINTS);
+    GrowIndex(dense_size);
+
+    // Above the dense range, allocate the pages holding glyphs only, numbered in codepoint order
+    if (max_codepoint >= dense_size)
+    {
+        PageMap.resize((max_codepoint >> IM_FONT_PAGE_SHIFT) + 1, (ImU16)0);
+        for (int i = 0; i < Glyphs.Size; i++)
+            if ((int)Glyphs[i].Codepoint >= dense_size)
+                PageMap[(int)Glyphs[i].Codepoint >> IM_FONT_PAGE_SHIFT] = 1;
+        int page_count = 0;
+        for (int page_n = 0; page_n < PageMap.Size; page_n++)
+            if (PageMap[page_n])
+                PageMap[page_n] = (ImU16)++page_count;
+        PagedAdvanceX.resize(page_count * IM_FONT_PAGE_SIZE, -1.0f);
+        PagedLookup.resize(page_count * IM_FONT_PAGE_SIZE, (ImWchar)-1);
+    }
+
     for (int i = 0; i < Glyphs.Size; i++)
     {
         int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImWchar)i;
+        float* advance_x;
+        ImWchar* index = ImFontLookupEntry(this, (unsigned int)codepoint, false, 0.0f, &advance_x);
+        *advance_x = Glyphs[i].AdvanceX;
+        *index = (ImWchar)i;
 
         // Mark 4K page as used
         const int page_n = codepoint / 4096;
@@ -3222,9 +3412,12 @@ void ImFont::BuildLookupTable()
     }
 
     FallbackAdvanceX = FallbackGlyph->AdvanceX;
-    for (int i = 0; i < max_codepoint + 1; i++)
+    for (int i = 0; i < IndexAdvanceX.Size; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
+    for (int i = 0; i < PagedAdvanceX.Size; i++)
+        if (PagedAdvanceX[i] < 0.0f)
+            PagedAdvanceX[i] = FallbackAdvanceX;
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3305,23 +3498,27 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    float* src_advance_x;
+    float* dst_advance_x;
+    const ImWchar* src_index = ImFontLookupEntry(this, src, false, 0.0f, &src_advance_x);
+    ImWchar* dst_index = ImFontLookupEntry(this, dst, false, 0.0f, &dst_advance_x);
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_index && *dst_index == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (!src_index && !dst_index) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    // Read 'src' before allocating a page for 'dst', which may move it
+    const ImWchar index = src_index ? *src_index : (ImWchar)-1;
+    const float advance_x = src_index ? *src_advance_x : 1.0f;
+    dst_index = ImFontLookupEntry(this, dst, true, FallbackAdvanceX, &dst_advance_x);
+    *dst_index = index;
+    *dst_advance_x = advance_x;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = ImFontLookupIndex(this, c);
     if (i == (ImWchar)-1)
         return FallbackGlyph;
     return &Glyphs.Data[i];
@@ -3329,14 +3526,75 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return NULL;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = ImFontLookupIndex(this, c);
     if (i == (ImWchar)-1)
         return NULL;
     return &Glyphs.Data[i];
 }
 
+// Length of the run of printable ASCII bytes (32..127) at s, up to text_end. With word_only, blanks and the
+// punctuation word wrapping breaks after end the run too. Bytes are tested 16 at a time: in a signed compare,
+// non-ASCII bytes are negative so "c < 32" catches them along with the control characters.
+// Such runs need no UTF-8 decoding and their advances all come from the first 128 entries of IndexAdvanceX.
+static inline int ImFontCountAsciiRun(const char* s, const char* text_end, bool word_only)
+{
+    const char* p = s;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i below = _mm_set1_epi8(32);
+    while (text_end - p >= 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i stop = _mm_cmplt_epi8(v, below);
+        if (word_only)
+        {
+            stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))));
+            stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')), _mm_cmpeq_epi8(v, _mm_set1_epi8(';'))));
+            stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('!')), _mm_cmpeq_epi8(v, _mm_set1_epi8('?'))));
+            stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8('\"')));
+        }
+        const int mask = _mm_movemask_epi8(stop);
+        if (mask != 0)
+#if defined(_MSC_VER) && !defined(__clang__)
+        {
+            unsigned long index;
+            _BitScanForward(&index, (unsigned long)mask);
+            return (int)(p - s) + (int)index;
+        }
+#else
+            return (int)(p - s) + __builtin_ctz((unsigned int)mask);
+#endif
+        p += 16;
+    }
+#endif
+    for (; p < text_end; p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        if (c < 32 || c >= 0x80)
+            break;
+        if (word_only && (c == ' ' || c == '.' || c == ',' || c == ';' || c == '!' || c == '?' || c == '\"'))
+            break;
+    }
+    return (int)(p - s);
+}
+
+// Sum of the advances of an ASCII run. Four independent sums keep the adds from waiting on each other,
+// which is what bounds the one-character-at-a-time loops; the rounding can differ from them in the last bits.
+static inline float ImFontSumAsciiAdvances(const float* ascii_advance_x, const char* s, int count)
+{
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+    int n = 0;
+    for (; n + 4 <= count; n += 4)
+    {
+        sum0 += ascii_advance_x[(unsigned char)s[n]];
+        sum1 += ascii_advance_x[(unsigned char)s[n + 1]];
+        sum2 += ascii_advance_x[(unsigned char)s[n + 2]];
+        sum3 += ascii_advance_x[(unsigned char)s[n + 3]];
+    }
+    for (; n < count; n++)
+        sum0 += ascii_advance_x[(unsigned char)s[n]];
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -3363,9 +3621,58 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* prev_word_end = NULL;
     bool inside_word = true;
 
+    // ASCII fast path: a run of plain characters (no blank, no punctuation) continues or starts a word, so it is
+    // summed in one go and the line width is checked once at its end. Widths only grow, so if the end fits every
+    // character before it did; otherwise the run is walked below.
+    const float* ascii_advance_x = IndexAdvanceX.Size >= 128 ? IndexAdvanceX.Data : NULL;
+    const char* slow_until = text;
+
     const char* s = text;
     while (s < text_end)
     {
+        if (ascii_advance_x && s >= slow_until && (unsigned char)*s > ' ' && (unsigned char)*s < 0x80)
+        {
+            const int run = ImFontCountAsciiRun(s, text_end, true);
+            if (run > 0)
+            {
+                // The first character of a new word moves the previous word and the blanks into the line, as below
+                float run_line_width = line_width;
+                float run_word_width;
+                if (inside_word)
+                {
+                    run_word_width = word_width + ImFontSumAsciiAdvances(ascii_advance_x, s, run);
+                }
+                else
+                {
+                    run_line_width = line_width + (word_width + ascii_advance_x[(unsigned char)*s]) + blank_width;
+                    run_word_width = ImFontSumAsciiAdvances(ascii_advance_x, s + 1, run - 1);
+                }
+                if (run_line_width + run_word_width <= wrap_width)
+                {
+                    if (!inside_word)
+                    {
+                        prev_word_end = word_end;
+                        blank_width = 0.0f;
+                        inside_word = true;
+                    }
+                    line_width = run_line_width;
+                    word_width = run_word_width;
+                    s += run;
+                    word_end = s;
+                    if (s < text_end && *s == ' ')
+                    {
+                        // the usual single space after the word: cannot overflow as blanks are not counted
+                        line_width += blank_width;
+                        blank_width = ascii_advance_x[' '];
+                        inside_word = false;
+                        s++;
+                    }
+                    continue;
+                }
+            }
+            slow_until = s + (run > 0 ? run : 1); // punctuation, or a run that does not fit
+        }
+
         unsigned int c = (unsigned int)*s;
         const char* next_s;
         if (c < 0x80)
@@ -3391,7 +3698,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+        const float char_width = GetCharAdvance((ImWchar)c);
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -3449,6 +3756,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    const float* ascii_advance_x = IndexAdvanceX.Size >= 128 ? IndexAdvanceX.Data : NULL;
+    const char* slow_until = text_begin;
 
     const char* s = text_begin;
     while (s < text_end)
@@ -3481,6 +3790,21 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // ASCII fast path: a run of printable characters is summed in one go and checked against max_width once at
+        // its end. Widths only grow, so if the end fits every character before it did; otherwise the run is walked below.
+        if (ascii_advance_x && s >= slow_until && (unsigned char)*s >= 32 && (unsigned char)*s < 0x80)
+        {
+            const int run = ImFontCountAsciiRun(s, word_wrap_eol ? word_wrap_eol : text_end, false);
+            const float run_line_width = line_width + ImFontSumAsciiAdvances(ascii_advance_x, s, run) * scale;
+            if (run_line_width < max_width)
+            {
+                line_width = run_line_width;
+                s += run;
+                continue;
+            }
+            slow_until = s + run;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3508,7 +3832,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+        const float char_width = GetCharAdvance((ImWchar)c) * scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
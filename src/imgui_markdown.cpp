@@ -1,13 +1,11 @@
 #include "imgui.h"
 #include "imgui_markdown.h"
+#include "MarkdownDocument.h"
 #include "IconsFontAwesome5.h"    // https://github.com/juliettef/IconFontCppHeaders
 #include "LoadImage.h"
-#include "imgui_impl_opengl3_loader.h"
 
-#ifdef WIN32
-#include <Windows.h>
-#include "Shellapi.h"
-#endif
+#include "LinkLauncher.h"
+
 #include <string>
 #include <iostream>
 
@@ -15,37 +13,31 @@
 static ImFont* H1 = NULL;
 static ImFont* H2 = NULL;
 static ImFont* H3 = NULL;
+static ImFont* Code = NULL;
 
 static ImGui::MarkdownConfig mdConfig;
 
-ListNode* ImageList = nullptr;
-
 
 void LinkCallback( ImGui::MarkdownLinkCallbackData data_ )
 {
-    std::string url( data_.link, data_.linkLength );
     if( !data_.isImage )
     {
-#ifdef WIN32
-        ShellExecuteA( NULL, "open", url.c_str(), NULL, NULL, SW_SHOWNORMAL );
-#else
-        system(("xdg-open " + url).c_str());
-#endif
+        OpenLinkAsync( data_.link, data_.linkLength );
     }
 }
 
 namespace ImGui
 {
-    inline ListNode* Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ )
+    void Markdown( const char* markdown_, size_t markdownLength_, const MarkdownConfig& mdConfig_ )
     {
+        ProfileTimer timer( PROFILE_MARKDOWN );
         static const char* linkHoverStart = NULL; // we need to preserve status of link hovering between frames
         ImGuiStyle& style = ImGui::GetStyle();
         Line        line;
         Link        link;
         Emphasis    em;
-        TextRegion  textRegion;
+        TextRegion  textRegion( &mdConfig_ );
 
-        ImageList = nullptr;
         char c = 0;
         for( int i=0; i < (int)markdownLength_; ++i ) {
             c = markdown_[i];               // get the character at index
@@ -154,11 +146,11 @@ namespace ImGui
                                 //MarkdownImageData imageData = mdConfig_.imageCallback( { markdown_ + link.text.start, link.text.size(), markdown_ + link.url.start, link.url.size(), mdConfig_.userData, true } );
 
                                 //vegeta
-                                MarkdownImageData imageData = mdConfig_.imageCallback( { std::string(markdown_).substr(link.text.start, link.text.size()).c_str(), link.text.size(), std::string(markdown_).substr(link.url.start, link.url.size()).c_str(), link.url.size(), mdConfig_.userData, true } );
+                                MarkdownImageData imageData = mdConfig_.imageCallback( { std::string(markdown_ + link.text.start, link.text.size()).c_str(), link.text.size(), std::string(markdown_ + link.url.start, link.url.size()).c_str(), link.url.size(), mdConfig_.userData, true } );
                                 useLinkCallback = imageData.useLinkCallback;
 
                                 if( imageData.isValid ) {
-                                    ImGui::Image((void*)(intptr_t)imageData.user_texture_id, imageData.size, imageData.uv0, imageData.uv1, imageData.tint_col, imageData.border_col );
+                                    ImGui::Image(imageData.user_texture_id, imageData.size, imageData.uv0, imageData.uv1, imageData.tint_col, imageData.border_col );
                                     drawnImage = true;
                                 }
                             }
@@ -309,23 +301,21 @@ namespace ImGui
                 RenderLine( markdown_, line, textRegion, mdConfig_ );
             }
         }
-        return ImageList;
     }
 }
 
 inline ImGui::MarkdownImageData ImageCallback( ImGui::MarkdownLinkCallbackData data_ )
 {
-    // In your application you would load an image based on data_ input. Here we just use the imgui font texture.
+    ProfileTimer timer( PROFILE_IMAGE );
+    // The image is loaded once and its texture shared by every document showing it
+    int my_image_width = 0 ;
+    int my_image_height = 0 ;
+    ImTextureID my_image_texture = 0 ;
 
-    static int my_image_width = 0 ;
-    static int my_image_height = 0 ;
-    GLuint my_image_texture = 0 ;
-
-    bool ret = LoadTextureFromFile(data_.link, &my_image_texture, &my_image_width, &my_image_height);
-    ImageList = new ListNode(my_image_texture, ImageList);
+    bool ret = GetCachedTexture(data_.link, &my_image_texture, &my_image_width, &my_image_height);
 
     ImGui::MarkdownImageData imageData;
-    imageData.isValid =         true;
+    imageData.isValid =         ret;
     imageData.useLinkCallback = false;
     imageData.user_texture_id = my_image_texture;
     imageData.size =            ImVec2( my_image_width, my_image_height );
@@ -343,10 +333,13 @@ inline ImGui::MarkdownImageData ImageCallback( ImGui::MarkdownLinkCallbackData d
     return imageData;
 }
 
-void LoadFonts( float fontSize_ = 12.0f )
+void LoadFonts( float fontSize_, bool signedDistanceField_ )
 {
+    ProfileTimer timer( PROFILE_FONTBUILD );
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     io.Fonts->Flags |= ImFontAtlasFlags_NoPowerOfTwoHeight;
+    if( signedDistanceField_ )
+        io.Fonts->Flags |= ImFontAtlasFlags_SignedDistanceField;
     FILE* inFile = fopen("../font/chinese3500.txt", "rb");
     unsigned char *charBuf;
     fseek(inFile, 0, SEEK_END);
@@ -363,7 +356,7 @@ void LoadFonts( float fontSize_ = 12.0f )
 
     //io.Fonts->Clear();
     // Base font
-    io.Fonts->AddFontFromFileTTF( "../font/FiraCode-Regular.ttf", fontSize_, NULL);
+    Code = io.Fonts->AddFontFromFileTTF( "../font/FiraCode-Regular.ttf", fontSize_, NULL);
     ImFontConfig cfg;
     cfg.MergeMode = true;
     cfg.OversampleV = 2;
@@ -376,8 +369,16 @@ void LoadFonts( float fontSize_ = 12.0f )
     H3 = mdConfig.headingFormats[ 1 ].font;
     // bold heading H1
     float fontSizeH1 = fontSize_ * 1.2f;
-    H1 = io.Fonts->AddFontFromFileTTF( "../font/FiraCode-Bold.ttf", fontSizeH1, NULL );
-    io.Fonts->AddFontFromFileTTF("../font/SourceHanMonoSC-Bold.otf", fontSizeH1, &cfg, myRange.Data);
+    if( signedDistanceField_ )
+    {
+        // drawn from the fields of H2, scaled: the atlas copies H2 into it after every build
+        H1 = io.Fonts->AddFontScaled( H2, fontSizeH1 / fontSize_ );
+    }
+    else
+    {
+        H1 = io.Fonts->AddFontFromFileTTF( "../font/FiraCode-Bold.ttf", fontSizeH1, NULL );
+        io.Fonts->AddFontFromFileTTF("../font/SourceHanMonoSC-Bold.otf", fontSizeH1, &cfg, myRange.Data);
+    }
     io.Fonts->Build();
 }
 
@@ -413,20 +414,33 @@ void ExampleMarkdownFormatCallback( const ImGui::MarkdownFormatInfo& markdownFor
     }
 }
 
-ListNode* Markdown( const std::string& markdown_ )
+static void SetupMarkdownConfig()
 {
-    // You can make your own Markdown function with your prefered string container and markdown config.
     // > C++14 can use ImGui::MarkdownConfig mdConfig{ LinkCallback, NULL, ImageCallback, ICON_FA_LINK, { { H1, true }, { H2, true }, { H3, false } }, NULL };
     mdConfig.linkCallback =         LinkCallback;
     mdConfig.tooltipCallback =      NULL;
     mdConfig.imageCallback =        ImageCallback;
     mdConfig.linkIcon =             ICON_FA_LINK;
+    mdConfig.codeFont =             Code;
     mdConfig.headingFormats[0] =    { H1, true };
     mdConfig.headingFormats[1] =    { H2, true };
     mdConfig.headingFormats[2] =    { H3, true };
     mdConfig.userData =             NULL;
     mdConfig.formatCallback =       ExampleMarkdownFormatCallback;
-    return ImGui::Markdown( markdown_.c_str(), markdown_.length(), mdConfig );
+}
+
+void Markdown( const std::string& markdown_ )
+{
+    // You can make your own Markdown function with your prefered string container and markdown config.
+    SetupMarkdownConfig();
+    ImGui::Markdown( markdown_.c_str(), markdown_.length(), mdConfig );
+}
+
+void Markdown( ImGui::MarkdownDocument& doc_ )
+{
+    // Only the blocks in view are rendered, so only the visible images keep their textures in use
+    SetupMarkdownConfig();
+    ImGui::RenderMarkdownDocument( doc_, mdConfig );
 }
 
 void MarkdownExample()
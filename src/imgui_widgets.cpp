@@ -3656,14 +3656,30 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_WIN(ImGuiInputTextState* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDRIGHT  STB_TEXTEDIT_MOVEWORDRIGHT_WIN
 #endif
 
+// UTF-8 offset of character pos, counted from the previous edit rather than from the start of the text, so typing
+// in a large text does not scan it. Called before the edit at pos is made: the text before pos is unchanged by it.
+static int InputTextEditOffsetA(ImGuiInputTextState* obj, int pos)
+{
+    const ImWchar* text = obj->TextW.Data;
+    if (pos >= obj->OffsetW)
+        obj->OffsetA += ImTextCountUtf8BytesFromStr(text + obj->OffsetW, text + pos);
+    else
+        obj->OffsetA -= ImTextCountUtf8BytesFromStr(text + pos, text + obj->OffsetW);
+    obj->OffsetW = pos;
+    return obj->OffsetA;
+}
+
 static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
 {
     ImWchar* dst = obj->TextW.Data + pos;
+    const int pos_a = InputTextEditOffsetA(obj, pos);
 
     // We maintain our buffer length in both UTF-8 and wchar formats
     obj->Edited = true;
     obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
     obj->CurLenW -= n;
+    obj->UnchangedHeadA = ImMin(obj->UnchangedHeadA, pos_a);
+    obj->UnchangedTailA = ImMin(obj->UnchangedTailA, obj->CurLenA - pos_a);
 
     // Offset remaining text (FIXME-OPT: Use memmove)
     const ImWchar* src = obj->TextW.Data + pos + n;
@@ -3691,6 +3707,7 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
         obj->TextW.resize(text_len + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1);
     }
 
+    const int pos_a = InputTextEditOffsetA(obj, pos);
     ImWchar* text = obj->TextW.Data;
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
@@ -3700,6 +3717,8 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->TextW[obj->CurLenW] = '\0';
+    obj->UnchangedHeadA = ImMin(obj->UnchangedHeadA, pos_a);
+    obj->UnchangedTailA = ImMin(obj->UnchangedTailA, obj->CurLenA - pos_a - new_text_len_utf8);
 
     return true;
 }
@@ -4024,8 +4043,11 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
         state->TextA.resize(0);
         state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
+        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, buf + buf_len, &buf_end);
         state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        if (state->CurLenA != state->CurLenW)       // Malformed UTF-8 comes back as U+FFFD: CurLenA is the length of the text TextW encodes to, as TextA will be.
+            state->CurLenA = ImTextCountUtf8BytesFromStr(state->TextW.Data, state->TextW.Data + state->CurLenW);
+        state->ResetChanged();                      // TextW may not encode back to buf: it all counts as changed.
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
@@ -4105,6 +4127,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);
+        state->ResetChanged();
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -4125,7 +4148,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         password_font->ContainerAtlas = g.Font->ContainerAtlas;
         password_font->FallbackGlyph = glyph;
         password_font->FallbackAdvanceX = glyph->AdvanceX;
-        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
+        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty() && password_font->PageMap.empty());
         PushFont(password_font);
     }
 
@@ -4412,7 +4435,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 state->TextAIsValid = true;
                 state->TextA.resize(state->TextW.Size * 4 + 1);
-                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, state->TextW.Data + state->CurLenW);
             }
 
             // User callback
@@ -4485,8 +4508,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
                         if (callback_data.BufTextLen > backup_current_text_length && is_resizable)
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length));
-                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
+                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, callback_data.Buf + callback_data.BufTextLen);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->ResetChanged();
                         state->CursorAnimReset();
                     }
                 }
@@ -8,12 +8,26 @@
 #include "imgui_impl_opengl3.h"
 #include <cstdlib>
 #include <stdio.h>
+#include <math.h>
 #if defined(IMGUI_IMPL_OPENGL_ES2)
 #include <GLES2/gl2.h>
 #endif
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 #include "imgui_markdown.h"       // https://github.com/juliettef/imgui_markdown
+#include "MarkdownDocument.h"
+#include "DocumentTabs.h"
+#include "FolderSearch.h"
+#include "WorkspaceIndex.h"
+#include "QuickOpen.h"
+#include "FileTail.h"
+#include "LinkLauncher.h"
+#include "LoadImage.h"
+#include "HtmlExport.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
 #include <iostream>
+#include <vector>
+#include <string.h>
 
 
 // [Win32] Our example includes a copy of glfw3.lib pre-compiled with VS2010 to maximize ease of testing and compatibility with old VS compilers.
@@ -23,15 +37,131 @@
 #pragma comment(lib, "legacy_stdio_definitions")
 #endif
 
-//extern ListNode* ImageListBak;
-
 static void glfw_error_callback(int error, const char* description)
 {
     fprintf(stderr, "Glfw Error %d: %s\n", error, description);
 }
 
-int main(int, char**)
+// Ctrl+wheel over the preview zooms it, Ctrl+0 resets. The glyphs are distance fields, so every size is
+// drawn sharp from the same atlas: zooming never rebuilds or re-uploads the font texture.
+static float previewZoom = 1.0f;
+static void ZoomPreview()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.KeyCtrl && ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows))
+    {
+        // with Ctrl held imgui does not scroll on the wheel
+        if (io.MouseWheel != 0.0f)
+        {
+            previewZoom *= powf(1.1f, io.MouseWheel);
+            previewZoom = previewZoom < 0.5f ? 0.5f : previewZoom > 4.0f ? 4.0f : previewZoom;
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_0, false))
+            previewZoom = 1.0f;
+    }
+    ImGui::SetWindowFontScale(previewZoom);
+}
+
+int main(int argc, char** argv)
 {
+    // Command line: ImGuiMarkdown [--trace trace.json] [file.md | folder] | --tail file.md | --html file.md...
+    const char* tailPath = NULL;
+    const char* tracePath = NULL;
+    const char* openPath = NULL;
+    bool exportHtml = false;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--tail") == 0 && i + 1 < argc)
+            tailPath = argv[++i];
+        else if (strcmp(argv[i], "--html") == 0)
+            exportHtml = true;
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (argv[i][0] != '-')
+        {
+            openPath = argv[i];
+            inputs.push_back(argv[i]);
+        }
+    }
+
+    // Recorded from the start, written on exit (or on Shift+F12)
+    if (tracePath && !Profiler::Shared().StartTrace(tracePath))
+        fprintf(stderr, "Cannot write %s\n", tracePath);
+
+    // Headless export: every file becomes file.html next to it, files in parallel and each file's blocks too
+    if (exportHtml)
+    {
+        std::vector<char> failed(inputs.size(), 0);
+        ThreadPool::Shared().ParallelFor((int)inputs.size(), 1, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                std::string output = inputs[i];
+                size_t dot = output.rfind('.');
+                if (dot != std::string::npos && output.find('/', dot) == std::string::npos)
+                    output.resize(dot);
+                output += ".html";
+                failed[i] = !ExportHtmlFile(inputs[i], output.c_str());
+                // no frames drain the profiler here
+                Profiler::Shared().Flush();
+            }
+        });
+        int errors = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            if (failed[i])
+            {
+                fprintf(stderr, "Cannot export %s\n", inputs[i]);
+                ++errors;
+            }
+        }
+        if (Profiler::Shared().IsTracing() && !Profiler::Shared().StopTrace())
+            fprintf(stderr, "Cannot write %s\n", tracePath);
+        return errors ? 1 : 0;
+    }
+
+    // The open documents; the preview shows the active one. In tail mode it follows a growing file instead of the editor.
+    DocumentTabs tabs;
+    FileTail tail;
+    ImVector<char> tailChunk;
+    FolderSearch notes;
+    WorkspaceIndex workspace;
+    QuickOpen quickOpen;
+    if (tailPath)
+    {
+        if (!tail.Open(tailPath))
+        {
+            fprintf(stderr, "Cannot open %s\n", tailPath);
+            return 1;
+        }
+        tabs.Add(tailPath)->doc.autoScroll = true;
+    }
+    else
+    {
+        // A folder argument is the workspace, else the folder of the note is: its index feeds the file tree.
+        // Without either there is no workspace, so a bare launch never walks (or writes an index into) the
+        // current directory.
+        std::string folder;
+        if (openPath && workspace.Open(openPath))
+        {
+            folder = openPath;
+            if (!tabs.Add(NULL))
+                return 1;
+        }
+        else if (openPath)
+        {
+            if (!tabs.Open(openPath))
+                return 1;
+            folder = strrchr(openPath, '/') ? std::string(openPath, strrchr(openPath, '/') - openPath) : std::string(".");
+            workspace.Open(folder.c_str());
+        }
+        else if (!tabs.Add(NULL))
+            return 1;
+        if (!folder.empty())
+            notes.SetFolder(folder.c_str());
+    }
+
     // Setup window
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit())
@@ -69,6 +199,7 @@ int main(int, char**)
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
+    Profiler::InstallAllocator();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
@@ -100,7 +231,17 @@ int main(int, char**)
     //ImFontConfig cfg;
     //cfg.MergeMode = true;
     //io.Fonts->AddFontFromFileTTF("/usr/share/fonts/wenquanyi/wqy-microhei/wqy-microhei.ttc", 16.0f, &cfg, io.Fonts->GetGlyphRangesChineseFull());
-    LoadFonts(16.0f);
+    // distance field glyphs: the OpenGL3 backend thresholds them, and the headings reuse the 16px fields.
+    // Computing the fields of the CJK glyphs is the slow part of the build, so it runs on the pool.
+    io.Fonts->BuildParallelForFn = [](int count, void (*job)(void*, int), void* user_data)
+    {
+        ThreadPool::Shared().ParallelFor(count, 16, [=](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+                job(user_data, i);
+        });
+    };
+    LoadFonts(16.0f, true);
     //io.Fonts->Build();
 
 
@@ -141,65 +282,78 @@ int main(int, char**)
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        Profiler& profiler = Profiler::Shared();
+        profiler.NewFrame();
 
         /*************************** CUSTOM BEGIN *************************/
-        struct Funcs
+        if (tail.IsOpen())
         {
-            static int MyResizeCallback(ImGuiInputTextCallbackData* data)
+            // only the appended bytes are read and parsed
+            OpenDocument* tailed = tabs.Active();
+            tailChunk.resize(0);
+            FileTail::PollResult res = tail.Poll(tailChunk);
+            if (res == FileTail::RELOADED)
             {
-                if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
-                {
-                    ImVector<char>* my_str = (ImVector<char>*)data->UserData;
-                    IM_ASSERT(my_str->begin() == data->Buf);
-                    my_str->resize(data->BufSize); // NB: On resizing calls, generally data->BufSize == data->BufTextLen + 1
-                    data->Buf = my_str->begin();
-                }
-                return 0;
+                tailed->doc.SetText(tailChunk.Data, (size_t)tailChunk.Size);
+                tailed->search.OnReload(tailed->doc);
             }
-
-            // Note: Because ImGui:: is a namespace you would typically add your own function into the namespace.
-            // For example, you code may declare a function 'ImGui::InputText(const char* label, MyString* my_str)'
-            static bool MyInputTextMultiline(const char* label, ImVector<char>* my_str, const ImVec2& size = ImVec2(0, 0), ImGuiInputTextFlags flags = 0)
+            else if (res == FileTail::APPENDED)
+            {
+                ImGui::MarkdownEdit edit;
+                edit.pos = tailed->doc.Length();
+                edit.insertLength = tailChunk.Size;
+                tailed->doc.Append(tailChunk.Data, (size_t)tailChunk.Size);
+                tailed->search.OnEdit(edit, tailed->doc);
+            }
+        }
+        else
+        {
+            tabs.ShowEditor();
+
+            std::string clicked = workspace.ShowTree();
+            if (!clicked.empty())
+                tabs.Open(clicked.c_str());
+            std::string chosen = quickOpen.Show(workspace);
+            if (!chosen.empty())
+                tabs.Open(chosen.c_str());
+            if (const FolderSearch::Hit* hit = notes.Show())
             {
-                IM_ASSERT((flags & ImGuiInputTextFlags_CallbackResize) == 0);
-                return ImGui::InputTextMultiline(label, my_str->begin(), (size_t)my_str->size(), size, flags | ImGuiInputTextFlags_CallbackResize, Funcs::MyResizeCallback, (void*)my_str);
+                if (OpenDocument* opened = tabs.Open(notes.files[hit->file].c_str()))
+                    opened->doc.scrollToBlock = opened->doc.FindBlockAt(hit->offset);
             }
-        };
+        }
+        tabs.Update();
 
-        static bool p_open = true;
-        ImGui::Begin("editor", &p_open);
+        if (OpenDocument* current = tabs.Active())
+        {
+            current->search.Show(current->doc);
 
-        static ImGuiInputTextFlags flags = ImGuiInputTextFlags_AllowTabInput;
-        static ImVector<char> my_str;
-        if (my_str.empty())
-            my_str.push_back(0);
-        Funcs::MyInputTextMultiline("##MyStr", &my_str, ImVec2(-FLT_MIN, -ImGui::GetTextLineHeight()*FLT_MIN), flags);
-        ImGui::End();
+            ImGui::Begin("outline");
+            ImGui::RenderMarkdownOutline(current->doc);
+            ImGui::End();
 
-        ListNode* ImageList = Markdown(my_str.Data);
+            ImGui::Begin("preview");
+            ZoomPreview();
+            Markdown(current->doc);
+            ImGui::End();
+        }
+        ShowLinkStatus();
+        profiler.Show();
 
 
         /*************************** CUSTOM END *************************/
 
         // Rendering
         ImGui::Render();
+        profiler.EndFrame(ImGui::GetDrawData());
         int display_w, display_h;
         glfwGetFramebufferSize(window, &display_w, &display_h);
         glViewport(0, 0, display_w, display_h);
         glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-        while(ImageList && ImageList->next) {
-            glDeleteTextures(1, &(ImageList->value));
-            ListNode* tmp = ImageList;
-            ImageList = ImageList->next;
-            delete tmp;
-        }
-        if (ImageList)
         {
-            glDeleteTextures(1, &(ImageList->value));
-            delete ImageList;
+            ProfileTimer timer(PROFILE_GLRENDER);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         }
 
         // Update and Render additional Platform Windows
@@ -217,6 +371,10 @@ int main(int, char**)
     }
 
     // Cleanup
+    if (Profiler::Shared().IsTracing())
+        Profiler::Shared().StopTrace();
+    tabs.CloseAll();
+    ReleaseTextures();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,143 @@
+// Headless renderer: draws a Markdown document with the preview of the editor and writes it to a PNG.
+// It needs no window and no GPU: the draw data is rasterized on the CPU by imgui_impl_softraster,
+// so it runs on build servers to make thumbnails of reports. The output is the same for any
+// number of threads, so two renders can be compared pixel by pixel.
+
+#include "imgui.h"
+#include "imgui_impl_softraster.h"
+#include "imgui_markdown.h"
+#include "MarkdownDocument.h"
+#include "LoadImage.h"
+#include "PngWriter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+static const int MAXHEIGHT = 32768;     // longer documents are cut
+static const int MAXLAYOUTFRAMES = 64;  // heights are measured as blocks are shown, this bounds the passes
+
+static void usage()
+{
+    fprintf(stderr, "Usage: ImGuiMarkdownRender [--width W] [--height H] [--threads N] file.md out.png\n"
+                    "  --width W     image width in pixels (default 800)\n"
+                    "  --height H    image height in pixels (default: the height of the document, up to %d)\n"
+                    "  --threads N   rasterizer threads (default: one per hardware thread)\n", MAXHEIGHT);
+}
+
+static bool read_file(const char* path, std::vector<char>& out)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return false;
+    char chunk[64 * 1024];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        out.insert(out.end(), chunk, chunk + n);
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+// One frame of the preview at the current io.DisplaySize
+static void render_frame(ImGui::MarkdownDocument& doc)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftraster_NewFrame();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("preview", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus);
+    Markdown(doc);
+    ImGui::End();
+    ImGui::Render();
+}
+
+int main(int argc, char** argv)
+{
+    int width = 800;
+    int height = 0;
+    int threads = 0;
+    const char* inputPath = NULL;
+    const char* outputPath = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--width") == 0 && i + 1 < argc)
+            width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && i + 1 < argc)
+            height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (argv[i][0] != '-' && !inputPath)
+            inputPath = argv[i];
+        else if (argv[i][0] != '-' && !outputPath)
+            outputPath = argv[i];
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+    if (!inputPath || !outputPath || width <= 0 || height < 0 || height > MAXHEIGHT)
+    {
+        usage();
+        return 2;
+    }
+
+    std::vector<char> text;
+    if (!read_file(inputPath, text))
+    {
+        fprintf(stderr, "Cannot read %s\n", inputPath);
+        return 1;
+    }
+    ImGui::MarkdownDocument doc;
+    doc.SetText(text.data(), text.size());
+
+    // Setup Dear ImGui context, without a platform backend: the display size and time step are set by hand
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::StyleColorsDark();
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.WindowRounding = 0.0f;
+    style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGui_ImplSoftraster_Init(threads);
+    SetTextureFunctions(ImGui_ImplSoftraster_CreateTexture, ImGui_ImplSoftraster_DestroyTexture);
+    LoadFonts(16.0f);
+
+    // Block heights are estimates until a block has been laid out once: grow the display to the
+    // document until its height stops changing, so every block is shown and measured.
+    io.DisplaySize = ImVec2((float)width, (float)(height > 0 ? height : 256));
+    int stable = 0;
+    for (int frame = 0; frame < MAXLAYOUTFRAMES && stable < 2; ++frame)
+    {
+        render_frame(doc);
+        if (height > 0)
+        {
+            ++stable;
+            continue;
+        }
+        float fit = ceilf(doc.totalHeight + style.WindowPadding.y * 2.0f);
+        fit = fit < 1.0f ? 1.0f : fit > (float)MAXHEIGHT ? (float)MAXHEIGHT : fit;
+        stable = fit == io.DisplaySize.y ? stable + 1 : 0;
+        io.DisplaySize.y = fit;
+    }
+    // the image is made from one more frame at the final size
+    render_frame(doc);
+
+    const int imageHeight = (int)io.DisplaySize.y;
+    std::vector<ImU32> pixels((size_t)width * imageHeight, ImGui::GetColorU32(ImGuiCol_WindowBg));
+    ImGui_ImplSoftraster_RenderDrawData(ImGui::GetDrawData(), pixels.data(), width, imageHeight);
+    bool written = WritePng(outputPath, (const unsigned char*)pixels.data(), width, imageHeight);
+    if (!written)
+        fprintf(stderr, "Cannot write %s\n", outputPath);
+
+    ReleaseTextures();
+    ImGui_ImplSoftraster_Shutdown();
+    ImGui::DestroyContext();
+    return written ? 0 : 1;
+}